@@ -0,0 +1,147 @@
+/**
+ * \file DeltaCodingBenchmark.cpp
+ * \brief Speed of DECODE_DELTA_64 and PREFIX_SUM_64 compared with scalar loops and memcpy, from L1 to DRAM
+ *
+ * Usage: DeltaCodingBenchmark [maxValuesInMi]
+ * Columns go from 1 Ki to maxValuesInMi (32 by default) BigEndian delta encoded values.
+ *
+ * One table per offset width, one row per column size, GB/s of decoded uint64_t:
+ * - memcpy: memcpy of the decoded column, the memory speed.
+ * - two pass: offsets widened with GET_UINTxx into the whole column, then summed by a scalar loop.
+ * - decode: DECODE_DELTA_64.
+ * - scalar sum: scalar prefix sum loop over the decoded column, in place.
+ * - PREFIX_SUM: PREFIX_SUM_64 over the decoded column, in place.
+ */
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <BigEndian.hpp>
+#include <DeltaCoding.hpp>
+
+// C++ Header
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_USING_NAMESPACE
+
+typedef DeltaCoding<BigEndian> Coding;
+
+static const int REPETITIONS = 3;
+/** Bytes decoded per measure for small columns, so the timer resolution doesn't matter */
+static const size_t MIN_BYTES_PER_MEASURE = size_t(64) << 20;
+
+/** Widen the offsets into the whole column, then sum it: the decoder without blocks nor SIMD scan */
+static void twoPassDecode(uint64_t* dest, const uint8_t* src, const size_t count)
+{
+    const uint8_t width = BigEndian::GET_UINT8(src, LibEndian::UINT64_SIZE);
+    const uint8_t* offsets = src + Coding::HEADER_SIZE;
+    dest[0] = BigEndian::GET_UINT64(src);
+    for(size_t i = 1; i < count; ++i)
+    {
+        switch(width)
+        {
+        case 1: dest[i] = BigEndian::GET_UINT8(offsets, i - 1); break;
+        case 2: dest[i] = BigEndian::GET_UINT16(offsets, (i - 1) * 2); break;
+        case 4: dest[i] = BigEndian::GET_UINT32(offsets, (i - 1) * 4); break;
+        default: dest[i] = BigEndian::GET_UINT64(offsets, (i - 1) * 8); break;
+        }
+    }
+    for(size_t i = 1; i < count; ++i)
+        dest[i] += dest[i - 1];
+}
+
+static void scalarSum(uint64_t* values, const size_t count)
+{
+    uint64_t carry = 0;
+    for(size_t i = 0; i < count; ++i)
+    {
+        carry += values[i];
+        values[i] = carry;
+    }
+}
+
+/** Best speed of REPETITIONS measures of run() on count values (in GB/s of uint64_t) */
+template<typename Run>
+static double measure(const size_t count, const Run& run)
+{
+    const size_t bytes = count * sizeof(uint64_t);
+    const size_t iterations = bytes >= MIN_BYTES_PER_MEASURE ? 1 : MIN_BYTES_PER_MEASURE / bytes;
+    // Warm up caches and TLB
+    run();
+
+    double best = 0;
+    for(int repetition = 0; repetition < REPETITIONS; ++repetition)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < iterations; ++i)
+            run();
+        const auto stop = std::chrono::steady_clock::now();
+        const double gbps = double(bytes) * double(iterations) / std::chrono::duration<double, std::nano>(stop - start).count();
+        if(gbps > best)
+            best = gbps;
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t maxMi = argc > 1 ? size_t(strtoul(argv[1], nullptr, 10)) : 32;
+    const size_t maxCount = (maxMi ? maxMi : 1) << 20;
+
+    std::vector<uint64_t> values(maxCount);
+    std::vector<uint64_t> decoded(maxCount);
+    std::vector<uint8_t> encoded(Coding::HEADER_SIZE + maxCount * sizeof(uint64_t));
+
+    printf("GB/s of decoded uint64_t, best of %d\n", REPETITIONS);
+    const uint64_t maxDeltas[] = { 0xFF, 0xFFFF, 0xFFFFFFFF, ~uint64_t(0) };
+    for(const uint64_t maxDelta: maxDeltas)
+    {
+        uint64_t value = 0;
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        for(size_t i = 0; i < maxCount; ++i)
+        {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            value += maxDelta == ~uint64_t(0) ? seed : (seed >> 32) % (maxDelta + 1);
+            values[i] = value;
+        }
+        // The width of the whole column, so that every size uses it
+        const uint8_t width = Coding::WIDTH_FOR(maxDelta);
+
+        printf("\n%d bytes offsets\n%10s %14s %14s %14s %14s %14s\n", int(width), "values",
+            "memcpy", "two pass", "decode", "scalar sum", "PREFIX_SUM");
+        for(size_t count = 1024; count <= maxCount; count *= 4)
+        {
+            Coding::ENCODE_DELTA_64(encoded.data(), values.data(), count);
+            std::vector<uint64_t> check(count);
+            twoPassDecode(check.data(), encoded.data(), count);
+            Coding::DECODE_DELTA_64(decoded.data(), encoded.data(), count);
+            if(memcmp(check.data(), decoded.data(), count * sizeof(uint64_t)) || memcmp(check.data(), values.data(), count * sizeof(uint64_t)))
+            {
+                fprintf(stderr, "%zu values of %d bytes offsets: decoded differently\n", count, int(width));
+                return 1;
+            }
+
+            if(count >= (size_t(1) << 20))
+                printf("%8zuMi", count >> 20);
+            else
+                printf("%8zuKi", count >> 10);
+            printf(" %14.2f", measure(count, [&]() { memcpy(decoded.data(), values.data(), count * sizeof(uint64_t)); }));
+            printf(" %14.2f", measure(count, [&]() { twoPassDecode(decoded.data(), encoded.data(), count); }));
+            printf(" %14.2f", measure(count, [&]() { Coding::DECODE_DELTA_64(decoded.data(), encoded.data(), count); }));
+            printf(" %14.2f", measure(count, [&]() { scalarSum(decoded.data(), count); }));
+            printf(" %14.2f\n", measure(count, [&]() { Coding::PREFIX_SUM_64(decoded.data(), count, 0); }));
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
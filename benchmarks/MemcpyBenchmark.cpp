@@ -0,0 +1,170 @@
+/**
+ * \file MemcpyBenchmark.cpp
+ * \brief Bandwidth of MEMCPY_16/32/64 compared with memcpy, from L1 to DRAM
+ *
+ * Usage: MemcpyBenchmark [maxSizeInMiB]
+ * Sizes go from 64 B to maxSizeInMiB (1024 by default), the buffers take twice that much memory.
+ *
+ * One table per buffer layout and alignment, one row per size, GB/s of bytes converted:
+ * - memcpy: memcpy, or memmove when the buffers overlap.
+ * - copyXX: MEMCPY_XX of the host byte order, that only copy.
+ * - swapXX: MEMCPY_XX of the other byte order, that byte swap.
+ * - swap32 cached/stream: MEMCPY_32 swapping with STORE_CACHED or STORE_STREAMING, to place STREAMING_THRESHOLD.
+ * Buffer layouts are disjoint, in place (dest == src) and overlap (dest = src + 64 bytes, the memmove case).
+ * Misaligned tables offset src by 1 byte from a cache line. Disjoint ones offset dest by 3 bytes, in place and
+ * overlap ones derive dest from src, so it is offset by 1 byte too.
+ */
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <BigEndian.hpp>
+#include <LittleEndian.hpp>
+#include <AlignedBuffer.hpp>
+
+// C++ Header
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_USING_NAMESPACE
+
+#ifdef LIBENDIAN_IS_BIG_ENDIAN
+typedef BigEndian HostOrder;
+typedef LittleEndian SwappedOrder;
+#else
+typedef LittleEndian HostOrder;
+typedef BigEndian SwappedOrder;
+#endif
+
+static const int REPETITIONS = 3;
+/** Bytes converted per measure for small sizes, so the timer resolution doesn't matter */
+static const size_t MIN_BYTES_PER_MEASURE = size_t(64) << 20;
+/** Shift of dest in the overlapping layout */
+static const size_t OVERLAP_SHIFT = 64;
+
+enum Layout
+{
+    DISJOINT,
+    IN_PLACE,
+    OVERLAP
+};
+
+static const char* const LAYOUT_NAMES[] = { "disjoint", "in place", "overlap" };
+
+typedef void (*Conversion)(uint8_t* dest, const uint8_t* src, const size_t size);
+
+static void memcpyOrMove(uint8_t* dest, const uint8_t* src, const size_t size)
+{
+    if(dest + size <= src || src + size <= dest)
+        memcpy(dest, src, size);
+    else
+        memmove(dest, src, size);
+}
+static void copy16(uint8_t* dest, const uint8_t* src, const size_t size) { HostOrder::MEMCPY_16(dest, src, size / 2); }
+static void copy32(uint8_t* dest, const uint8_t* src, const size_t size) { HostOrder::MEMCPY_32(dest, src, size / 4); }
+static void copy64(uint8_t* dest, const uint8_t* src, const size_t size) { HostOrder::MEMCPY_64(dest, src, size / 8); }
+static void swap16(uint8_t* dest, const uint8_t* src, const size_t size) { SwappedOrder::MEMCPY_16(dest, src, size / 2); }
+static void swap32(uint8_t* dest, const uint8_t* src, const size_t size) { SwappedOrder::MEMCPY_32(dest, src, size / 4); }
+static void swap64(uint8_t* dest, const uint8_t* src, const size_t size) { SwappedOrder::MEMCPY_64(dest, src, size / 8); }
+static void swap32Cached(uint8_t* dest, const uint8_t* src, const size_t size) { SwappedOrder::MEMCPY_32(dest, src, size / 4, LibEndian::STORE_CACHED); }
+static void swap32Streaming(uint8_t* dest, const uint8_t* src, const size_t size) { SwappedOrder::MEMCPY_32(dest, src, size / 4, LibEndian::STORE_STREAMING); }
+
+struct Column
+{
+    const char* name;
+    Conversion conversion;
+};
+
+static const Column COLUMNS[] =
+{
+    { "memcpy", memcpyOrMove },
+    { "copy16", copy16 },
+    { "copy32", copy32 },
+    { "copy64", copy64 },
+    { "swap16", swap16 },
+    { "swap32", swap32 },
+    { "swap64", swap64 },
+    { "swap32 cached", swap32Cached },
+    { "swap32 stream", swap32Streaming },
+};
+static const size_t COLUMN_COUNT = sizeof(COLUMNS) / sizeof(COLUMNS[0]);
+
+/** Best bandwidth of REPETITIONS measures (in GB/s) */
+static double measure(const Conversion conversion, uint8_t* dest, const uint8_t* src, const size_t size)
+{
+    const size_t iterations = size >= MIN_BYTES_PER_MEASURE ? 1 : MIN_BYTES_PER_MEASURE / size;
+    // Warm up caches and TLB
+    conversion(dest, src, size);
+
+    double best = 0;
+    for(int run = 0; run < REPETITIONS; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for(size_t i = 0; i < iterations; ++i)
+            conversion(dest, src, size);
+        const auto stop = std::chrono::steady_clock::now();
+        const double gbps = double(size) * double(iterations) / std::chrono::duration<double, std::nano>(stop - start).count();
+        if(gbps > best)
+            best = gbps;
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t maxMiB = argc > 1 ? size_t(strtoul(argv[1], nullptr, 10)) : 1024;
+    const size_t maxSize = (maxMiB ? maxMiB : 1) << 20;
+
+    // One cache line of margin for misalignment and the overlap shift
+    AlignedBuffer<64> srcBuffer(maxSize + 2 * OVERLAP_SHIFT);
+    AlignedBuffer<64> destBuffer(maxSize + 2 * OVERLAP_SHIFT);
+    uint8_t* const srcBase = srcBuffer.data().get();
+    uint8_t* const destBase = destBuffer.data().get();
+    for(size_t i = 0; i < maxSize + 2 * OVERLAP_SHIFT; ++i)
+        srcBase[i] = uint8_t(i * 2654435761u >> 24);
+    memset(destBase, 0, maxSize + 2 * OVERLAP_SHIFT);
+
+    printf("GB/s, best of %d. Host order: %s, STREAMING_THRESHOLD: %zu bytes\n",
+        REPETITIONS, HostOrder::IS_BIG_ORDER ? "big" : "little", size_t(LibEndian::STREAMING_THRESHOLD));
+
+    for(int layout = DISJOINT; layout <= OVERLAP; ++layout)
+    {
+        for(int misaligned = 0; misaligned < 2; ++misaligned)
+        {
+            uint8_t* const src = srcBase + (misaligned ? 1 : 0);
+            uint8_t* dest = destBase + (misaligned ? 3 : 0);
+            if(layout == IN_PLACE)
+                dest = src;
+            else if(layout == OVERLAP)
+                dest = src + OVERLAP_SHIFT;
+
+            printf("\n%s, %s\n%10s", LAYOUT_NAMES[layout], misaligned ? "misaligned" : "cache line aligned", "size");
+            for(size_t c = 0; c < COLUMN_COUNT; ++c)
+                printf(" %14s", COLUMNS[c].name);
+            printf("\n");
+
+            for(size_t size = 64; size <= maxSize; size *= 2)
+            {
+                if(size >= (size_t(1) << 20))
+                    printf("%8zuMi", size >> 20);
+                else if(size >= 1024)
+                    printf("%8zuKi", size >> 10);
+                else
+                    printf("%10zu", size);
+                for(size_t c = 0; c < COLUMN_COUNT; ++c)
+                    printf(" %14.2f", measure(COLUMNS[c].conversion, dest, src, size));
+                printf("\n");
+                fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * \file RuntimeSchemaBenchmark.cpp
+ * \brief Compare RuntimeSchema with hand written decoding and with a switch per field
+ *
+ * Usage: RuntimeSchemaBenchmark [recordCount]
+ * Build with -DLIBENDIAN_DISABLE_COMPUTED_GOTO to measure the switch dispatch of RuntimeSchema.
+ */
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <BigEndian.hpp>
+#include <RuntimeSchema.hpp>
+
+// C++ Header
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_USING_NAMESPACE
+
+typedef RuntimeSchema<BigEndian> Schema;
+
+static const int REPETITIONS = 5;
+
+/** Native record, what RuntimeSchema produce for the fields of SCHEMA */
+struct Record
+{
+    uint32_t id;
+    uint32_t flags;
+    uint16_t channel;
+    uint16_t sequence;
+    float x;
+    float y;
+    float z;
+    int64_t timestamp;
+    uint8_t status[2];
+    double value;
+};
+
+struct FieldList
+{
+    Schema::FieldType type;
+    size_t count;
+};
+
+static const FieldList SCHEMA[] =
+{
+    { Schema::FIELD_UINT32, 2 },
+    { Schema::FIELD_UINT16, 2 },
+    { Schema::FIELD_FLOAT32, 3 },
+    { Schema::FIELD_INT48, 1 },
+    { Schema::FIELD_UINT8, 2 },
+    { Schema::FIELD_FLOAT64, 1 },
+};
+static const size_t SCHEMA_SIZE = sizeof(SCHEMA) / sizeof(SCHEMA[0]);
+
+/** Decoding written by hand for the format, the reference */
+static void decodeStatic(Record* dest, const uint8_t* src, const size_t count)
+{
+    for(size_t i = 0; i < count; ++i, src += 40)
+    {
+        Record& r = dest[i];
+        r.id = BigEndian::GET_UINT32(src);
+        r.flags = BigEndian::GET_UINT32(src + 4);
+        r.channel = BigEndian::GET_UINT16(src + 8);
+        r.sequence = BigEndian::GET_UINT16(src + 10);
+        r.x = BigEndian::GET_FLOAT32(src + 12);
+        r.y = BigEndian::GET_FLOAT32(src + 16);
+        r.z = BigEndian::GET_FLOAT32(src + 20);
+        r.timestamp = BigEndian::GET_INT48(src + 24);
+        r.status[0] = src[30];
+        r.status[1] = src[31];
+        r.value = BigEndian::GET_FLOAT64(src + 32);
+    }
+}
+
+/** Interpretation of the field list with a switch per field, what RuntimeSchema replace */
+static void decodeSwitch(uint8_t* dest, const uint8_t* src, const size_t count, const Schema& schema)
+{
+    for(size_t i = 0; i < count; ++i, dest += schema.nativeSize())
+    {
+        size_t field = 0;
+        for(size_t f = 0; f < SCHEMA_SIZE; ++f)
+        {
+            for(size_t n = 0; n < SCHEMA[f].count; ++n, ++field)
+            {
+                uint8_t* out = dest + schema.nativeOffset(field);
+                switch(SCHEMA[f].type)
+                {
+                case Schema::FIELD_UINT8: *out = *src; break;
+                case Schema::FIELD_UINT16: { const uint16_t v = BigEndian::GET_UINT16(src); memcpy(out, &v, 2); break; }
+                case Schema::FIELD_UINT32: { const uint32_t v = BigEndian::GET_UINT32(src); memcpy(out, &v, 4); break; }
+                case Schema::FIELD_FLOAT32: { const float v = BigEndian::GET_FLOAT32(src); memcpy(out, &v, 4); break; }
+                case Schema::FIELD_INT48: { const int64_t v = BigEndian::GET_INT48(src); memcpy(out, &v, 8); break; }
+                case Schema::FIELD_FLOAT64: { const double v = BigEndian::GET_FLOAT64(src); memcpy(out, &v, 8); break; }
+                default: break;
+                }
+                src += Schema::SERIALIZED_SIZE(SCHEMA[f].type);
+            }
+        }
+    }
+}
+
+/** Compare every byte of the records: pseudo-random doubles can be NaN, that != reject */
+static bool sameRecords(const std::vector<Record>& records, const std::vector<Record>& expected, const char* decoder)
+{
+    for(size_t i = 0; i < records.size(); ++i)
+    {
+        if(memcmp(&records[i], &expected[i], sizeof(Record)))
+        {
+            fprintf(stderr, "%s decoded record %zu differently\n", decoder, i);
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Best time of REPETITIONS runs (in nanoseconds per record) */
+template<typename Decode>
+static double measure(const size_t count, const Decode& decode)
+{
+    double best = 0;
+    for(int run = 0; run < REPETITIONS; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        decode();
+        const auto stop = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / double(count);
+        if(run == 0 || ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t count = argc > 1 ? size_t(strtoul(argv[1], nullptr, 10)) : 1000000;
+
+    Schema schema;
+    for(size_t f = 0; f < SCHEMA_SIZE; ++f)
+        schema.add(SCHEMA[f].type, SCHEMA[f].count);
+    if(schema.size() != 40 || schema.nativeSize() != sizeof(Record) || schema.nativeOffset(7) != offsetof(Record, timestamp))
+    {
+        fprintf(stderr, "RuntimeSchema layout doesn't match Record\n");
+        return EXIT_FAILURE;
+    }
+
+    std::vector<uint8_t> src(count * schema.size());
+    for(size_t i = 0; i < src.size(); ++i)
+        src[i] = uint8_t(i * 2654435761u >> 24);
+    // Zero initialized, padding included: the decoders leave it untouched, so records compare with memcmp
+    std::vector<Record> expected(count);
+    std::vector<Record> records(count);
+
+    const double staticNs = measure(count, [&] { decodeStatic(expected.data(), src.data(), count); });
+    const double schemaNs = measure(count, [&] { schema.decode(records.data(), src.data(), count); });
+    if(!sameRecords(records, expected, "RuntimeSchema"))
+        return EXIT_FAILURE;
+    const double switchNs = measure(count, [&] { decodeSwitch(reinterpret_cast<uint8_t*>(records.data()), src.data(), count, schema); });
+    if(!sameRecords(records, expected, "switch per field"))
+        return EXIT_FAILURE;
+
+#ifdef LIBENDIAN_HAS_COMPUTED_GOTO
+    const char* dispatch = "computed goto";
+#else
+    const char* dispatch = "switch";
+#endif
+    printf("%zu records of %zu bytes, %zu fields, %zu ops (%s), ns per record (best of %d)\n",
+        count, schema.size(), schema.fieldCount(), schema.opCount(), dispatch, REPETITIONS);
+    printf("%16s %10.3f\n", "static", staticNs);
+    printf("%16s %10.3f %9.2fx\n", "RuntimeSchema", schemaNs, schemaNs / staticNs);
+    printf("%16s %10.3f %9.2fx\n", "switch per field", switchNs, switchNs / staticNs);
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * \file SearchIndexBenchmark.cpp
+ * \brief Measure SearchIndex lookups against binary searches over sorted serialized keys
+ *
+ * Usage: SearchIndexBenchmark [maxKeysInMi]
+ * Tables go from 1 Ki to maxKeysInMi (16 by default) uint32 BigEndian keys, queried with random keys half of
+ * which are missing. ns per lookup (best of REPETITIONS) for:
+ * - decode: binary search over the serialized keys, decoding the key at every probe.
+ * - native: std::lower_bound over keys decoded beforehand.
+ * - index: SearchIndex<BigEndian, uint32_t>::lowerBound.
+ */
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <BigEndian.hpp>
+#include <SearchIndex.hpp>
+
+// C++ Header
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_USING_NAMESPACE
+
+static const int REPETITIONS = 3;
+static const size_t LOOKUPS = size_t(1) << 20;
+
+/** Rank of the first serialized key not less than key, decoding the key at every probe */
+static size_t decodeLowerBound(const uint8_t* keys, const size_t count, const uint32_t key)
+{
+    size_t first = 0;
+    size_t length = count;
+    while(length)
+    {
+        const size_t half = length / 2;
+        if(BigEndian::GET_UINT32(keys + (first + half) * sizeof(uint32_t)) < key)
+        {
+            first += half + 1;
+            length -= half + 1;
+        }
+        else
+            length = half;
+    }
+    return first;
+}
+
+/** Best time of REPETITIONS runs (in nanoseconds per lookup), the sum of the ranks goes to checksum */
+template<typename Search>
+static double measure(const std::vector<uint32_t>& queries, const Search& search, uint64_t& checksum)
+{
+    double best = 0;
+    for(int run = 0; run < REPETITIONS; ++run)
+    {
+        uint64_t sum = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for(const uint32_t query: queries)
+            sum += search(query);
+        const auto stop = std::chrono::steady_clock::now();
+        checksum = sum;
+
+        const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / double(queries.size());
+        if(run == 0 || ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t maxMi = argc > 1 ? size_t(strtoul(argv[1], nullptr, 10)) : 16;
+    const size_t maxCount = (maxMi ? maxMi : 1) << 20;
+
+    std::vector<uint32_t> queries(LOOKUPS);
+    uint64_t seed = 0x9E3779B97F4A7C15ull;
+
+    printf("uint32 BigEndian keys, %zu random lookups, ns per lookup (best of %d)\n", LOOKUPS, REPETITIONS);
+    printf("%10s %10s %10s %10s %10s\n", "keys", "decode", "native", "index", "speed-up");
+
+    for(size_t count = 1024; count <= maxCount; count *= 4)
+    {
+        // Odd keys, so that even queries are missing
+        std::vector<uint8_t> keys(count * sizeof(uint32_t));
+        std::vector<uint32_t> native(count);
+        for(size_t i = 0; i < count; ++i)
+        {
+            native[i] = uint32_t(2 * i + 1);
+            BigEndian::SET_UINT32(keys.data() + i * sizeof(uint32_t), native[i]);
+        }
+        for(uint32_t& query: queries)
+        {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            query = uint32_t((seed >> 32) % (2 * count + 1));
+        }
+
+        SearchIndex<BigEndian, uint32_t> index;
+        index.build(keys.data(), count);
+
+        uint64_t decodeSum = 0, nativeSum = 0, indexSum = 0;
+        const double decode = measure(queries, [&](const uint32_t key)
+        {
+            return decodeLowerBound(keys.data(), count, key);
+        }, decodeSum);
+        const double sorted = measure(queries, [&](const uint32_t key)
+        {
+            return size_t(std::lower_bound(native.begin(), native.end(), key) - native.begin());
+        }, nativeSum);
+        const double indexed = measure(queries, [&](const uint32_t key)
+        {
+            return index.lowerBound(key);
+        }, indexSum);
+
+        if(decodeSum != nativeSum || decodeSum != indexSum)
+        {
+            fprintf(stderr, "%zu keys: lookups disagree\n", count);
+            return 1;
+        }
+        if(count >= (size_t(1) << 20))
+            printf("%8zuMi", count >> 20);
+        else
+            printf("%8zuKi", count >> 10);
+        printf(" %10.1f %10.1f %10.1f %9.2fx\n", decode, sorted, indexed, decode / indexed);
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * \file StridedReaderBenchmark.cpp
+ * \brief Measure StridedReader with and without prefetch when the record stride grows
+ *
+ * Usage: StridedReaderBenchmark [bufferSizeInMiB]
+ * The buffer must be much bigger than the last level cache, 256 MiB by default.
+ */
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <BigEndian.hpp>
+#include <StridedReader.hpp>
+
+// C++ Header
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_USING_NAMESPACE
+
+static const size_t FIELD_OFFSET = 4;
+static const int REPETITIONS = 3;
+
+/** Best time of REPETITIONS runs (in nanoseconds per record) */
+static double measure(const std::vector<uint8_t>& records, std::vector<uint32_t>& values,
+    const size_t stride, const size_t count, const size_t distance, uint64_t& checksum)
+{
+    double best = 0;
+    for(int run = 0; run < REPETITIONS; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        StridedReader<BigEndian>::GET_UINT32_STRIDED(values.data(), records.data(), stride, count, FIELD_OFFSET, distance);
+        const auto stop = std::chrono::steady_clock::now();
+
+        for(size_t i = 0; i < count; i += 64)
+            checksum += values[i];
+
+        const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / double(count);
+        if(run == 0 || ns < best)
+            best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char** argv)
+{
+    const size_t sizeMiB = argc > 1 ? size_t(strtoul(argv[1], nullptr, 10)) : 256;
+    const size_t size = sizeMiB * 1024 * 1024;
+
+    std::vector<uint8_t> records(size);
+    for(size_t i = 0; i + 4 <= size; i += 4)
+        BigEndian::SET_UINT32(records.data() + i, uint32_t(i * 2654435761u));
+
+    const size_t distances[] = { 0, 4, 8, 16, 32, 64 };
+    const size_t distanceCount = sizeof(distances) / sizeof(distances[0]);
+
+    printf("buffer: %zu MiB, field: UINT32 at offset %zu, ns per record (best of %d)\n", sizeMiB, FIELD_OFFSET, REPETITIONS);
+    printf("%8s %10s", "stride", "records");
+    for(size_t d = 0; d < distanceCount; ++d)
+        printf("   dist=%-3zu", distances[d]);
+    printf("   speed-up\n");
+
+    uint64_t checksum = 0;
+    for(size_t stride = 8; stride <= 4096; stride *= 2)
+    {
+        const size_t count = size / stride;
+        std::vector<uint32_t> values(count);
+
+        printf("%8zu %10zu", stride, count);
+        double baseline = 0;
+        double best = 0;
+        for(size_t d = 0; d < distanceCount; ++d)
+        {
+            const double ns = measure(records, values, stride, count, distances[d], checksum);
+            if(d == 0)
+                baseline = best = ns;
+            else if(ns < best)
+                best = ns;
+            printf(" %10.3f", ns);
+        }
+        printf(" %9.2fx\n", baseline / best);
+    }
+
+    printf("checksum: %llu\n", (unsigned long long)checksum);
+    return 0;
+}
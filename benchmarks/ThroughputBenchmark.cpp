@@ -0,0 +1,279 @@
+/**
+ * \file ThroughputBenchmark.cpp
+ * \brief Measure encode and decode throughput of whole records, and compare it with a baseline
+ *
+ * Usage: ThroughputBenchmark [--size-mib N] [--repetitions N] [--json output.json] [--compare baseline.json] [--tolerance 0.1]
+ *
+ * Each corpus hold records of one size (32 B to 64 KiB) in one byte order. A record is an 8 bytes header
+ * (UINT32 size, UINT16 type, UINT16 entry count) followed by entries mixing 8, 16, 32 and 64 bits fields, and
+ * padding up to the record size. Encode serialize native entries with SET_*, decode check the header and
+ * deserialize the entries with GET_*.
+ *
+ * --json write the results. --compare read a file written by --json and exit with 1 if the throughput of a
+ * corpus dropped by more than the tolerance (10% by default). Compare builds of the same machine only.
+ */
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <BigEndian.hpp>
+#include <LittleEndian.hpp>
+
+// C++ Header
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_USING_NAMESPACE
+
+static const size_t HEADER_SIZE = 8;
+static const size_t ENTRY_SIZE = 24;
+static const size_t RECORD_SIZES[] = { 32, 256, 2048, 16384, 65536 };
+static const uint16_t RECORD_TYPE = 0x5245;
+
+/** Native form of an entry */
+struct Entry
+{
+    uint32_t id;
+    uint16_t channel;
+    uint8_t flags;
+    uint8_t quality;
+    uint64_t timestamp;
+    double value;
+};
+
+struct Result
+{
+    std::string name;
+    double gbps;
+    double recordsPerSecond;
+};
+
+template<class Endian>
+static void encode(uint8_t* dest, const Entry* entries, const size_t recordSize, const size_t recordCount)
+{
+    const size_t perRecord = (recordSize - HEADER_SIZE) / ENTRY_SIZE;
+    for(size_t r = 0; r < recordCount; ++r, dest += recordSize, entries += perRecord)
+    {
+        Endian::SET_UINT32(dest, uint32_t(recordSize));
+        Endian::SET_UINT16(dest + 4, RECORD_TYPE);
+        Endian::SET_UINT16(dest + 6, uint16_t(perRecord));
+        uint8_t* out = dest + HEADER_SIZE;
+        for(size_t i = 0; i < perRecord; ++i, out += ENTRY_SIZE)
+        {
+            const Entry& e = entries[i];
+            Endian::SET_UINT32(out, e.id);
+            Endian::SET_UINT16(out + 4, e.channel);
+            Endian::SET_UINT8(out + 6, e.flags);
+            Endian::SET_UINT8(out + 7, e.quality);
+            Endian::SET_UINT64(out + 8, e.timestamp);
+            Endian::SET_FLOAT64(out + 16, e.value);
+        }
+    }
+}
+
+/** Return false if a header is corrupted */
+template<class Endian>
+static bool decode(Entry* entries, const uint8_t* src, const size_t recordSize, const size_t recordCount)
+{
+    for(size_t r = 0; r < recordCount; ++r, src += recordSize)
+    {
+        if(Endian::GET_UINT32(src) != recordSize || Endian::GET_UINT16(src + 4) != RECORD_TYPE)
+            return false;
+        const size_t perRecord = Endian::GET_UINT16(src + 6);
+        if(HEADER_SIZE + perRecord * ENTRY_SIZE > recordSize)
+            return false;
+        const uint8_t* in = src + HEADER_SIZE;
+        for(size_t i = 0; i < perRecord; ++i, in += ENTRY_SIZE)
+        {
+            Entry& e = *entries++;
+            e.id = Endian::GET_UINT32(in);
+            e.channel = Endian::GET_UINT16(in + 4);
+            e.flags = Endian::GET_UINT8(in + 6);
+            e.quality = Endian::GET_UINT8(in + 7);
+            e.timestamp = Endian::GET_UINT64(in + 8);
+            e.value = Endian::GET_FLOAT64(in + 16);
+        }
+    }
+    return true;
+}
+
+/** Best time of repetitions runs (in seconds) */
+template<typename Job>
+static double measure(const int repetitions, const Job& job)
+{
+    double best = 0;
+    for(int run = 0; run < repetitions; ++run)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        job();
+        const auto stop = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>(stop - start).count();
+        if(run == 0 || seconds < best)
+            best = seconds;
+    }
+    return best;
+}
+
+template<class Endian>
+static bool run(const char* order, const size_t corpusSize, const int repetitions, std::vector<Result>& results)
+{
+    for(const size_t recordSize: RECORD_SIZES)
+    {
+        const size_t recordCount = corpusSize / recordSize;
+        const size_t perRecord = (recordSize - HEADER_SIZE) / ENTRY_SIZE;
+        const size_t bytes = recordCount * recordSize;
+
+        // Realistic values: growing ids and timestamps, few channels, smooth measures
+        std::vector<Entry> entries(recordCount * perRecord);
+        uint64_t seed = 0x9E3779B97F4A7C15ull;
+        for(size_t i = 0; i < entries.size(); ++i)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            entries[i].id = uint32_t(i);
+            entries[i].channel = uint16_t(seed % 16);
+            entries[i].flags = uint8_t(seed >> 8);
+            entries[i].quality = uint8_t(seed >> 16) % 101;
+            entries[i].timestamp = 1600000000000000ull + i * 1000 + (seed >> 54);
+            entries[i].value = 20.0 + double(seed >> 40) / double(1 << 24);
+        }
+        std::vector<uint8_t> buffer(bytes, 0);
+        std::vector<Entry> decoded(entries.size());
+
+        const double encodeSeconds = measure(repetitions, [&] { encode<Endian>(buffer.data(), entries.data(), recordSize, recordCount); });
+        bool valid = true;
+        const double decodeSeconds = measure(repetitions, [&] { valid &= decode<Endian>(decoded.data(), buffer.data(), recordSize, recordCount); });
+        if(!valid || (!entries.empty() && memcmp(&decoded.back(), &entries.back(), sizeof(Entry))))
+        {
+            fprintf(stderr, "%s records of %zu bytes don't round trip\n", order, recordSize);
+            return false;
+        }
+
+        const std::string suffix = std::string("/") + order + "/" + std::to_string(recordSize);
+        results.push_back({ "encode" + suffix, double(bytes) / encodeSeconds / 1e9, double(recordCount) / encodeSeconds });
+        results.push_back({ "decode" + suffix, double(bytes) / decodeSeconds / 1e9, double(recordCount) / decodeSeconds });
+    }
+    return true;
+}
+
+static bool writeJson(const std::string& path, const std::vector<Result>& results)
+{
+    std::ofstream out(path);
+    out << "[\n";
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        out << "  { \"name\": \"" << results[i].name << "\", \"gbps\": " << results[i].gbps
+            << ", \"records_per_s\": " << results[i].recordsPerSecond << " }" << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "]\n";
+    return bool(out);
+}
+
+/** Read the gbps of every name of a file written by writeJson */
+static bool readJson(const std::string& path, std::map<std::string, double>& baseline)
+{
+    std::ifstream in(path);
+    if(!in)
+        return false;
+    std::string line;
+    while(std::getline(in, line))
+    {
+        const size_t name = line.find("\"name\": \"");
+        const size_t gbps = line.find("\"gbps\": ");
+        if(name == std::string::npos || gbps == std::string::npos)
+            continue;
+        const size_t begin = name + 9;
+        const size_t end = line.find('"', begin);
+        baseline[line.substr(begin, end - begin)] = strtod(line.c_str() + gbps + 8, nullptr);
+    }
+    return !baseline.empty();
+}
+
+int main(int argc, char** argv)
+{
+    size_t sizeMiB = 64;
+    int repetitions = 5;
+    double tolerance = 0.1;
+    std::string jsonPath;
+    std::string comparePath;
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(i + 1 >= argc)
+        {
+            fprintf(stderr, "Missing value after %s\n", arg.c_str());
+            return EXIT_FAILURE;
+        }
+        if(arg == "--size-mib")
+            sizeMiB = size_t(strtoul(argv[++i], nullptr, 10));
+        else if(arg == "--repetitions")
+            repetitions = atoi(argv[++i]);
+        else if(arg == "--json")
+            jsonPath = argv[++i];
+        else if(arg == "--compare")
+            comparePath = argv[++i];
+        else if(arg == "--tolerance")
+            tolerance = strtod(argv[++i], nullptr);
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", arg.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+    if(repetitions < 1)
+        repetitions = 1;
+
+    const size_t corpusSize = sizeMiB * 1024 * 1024;
+    std::vector<Result> results;
+    if(!run<BigEndian>("big", corpusSize, repetitions, results) || !run<LittleEndian>("little", corpusSize, repetitions, results))
+        return EXIT_FAILURE;
+
+    printf("corpus: %zu MiB per record size, best of %d\n", sizeMiB, repetitions);
+    printf("%-24s %10s %14s\n", "corpus", "GB/s", "records/s");
+    for(const Result& result: results)
+        printf("%-24s %10.3f %14.0f\n", result.name.c_str(), result.gbps, result.recordsPerSecond);
+
+    if(!jsonPath.empty() && !writeJson(jsonPath, results))
+    {
+        fprintf(stderr, "Can't write %s\n", jsonPath.c_str());
+        return EXIT_FAILURE;
+    }
+
+    if(comparePath.empty())
+        return EXIT_SUCCESS;
+
+    std::map<std::string, double> baseline;
+    if(!readJson(comparePath, baseline))
+    {
+        fprintf(stderr, "Can't read a baseline from %s\n", comparePath.c_str());
+        return EXIT_FAILURE;
+    }
+    int regressions = 0;
+    printf("\ncompared with %s, tolerance %.0f%%\n", comparePath.c_str(), tolerance * 100);
+    for(const Result& result: results)
+    {
+        const auto it = baseline.find(result.name);
+        if(it == baseline.end() || it->second <= 0)
+            continue;
+        const double ratio = result.gbps / it->second;
+        const bool regressed = ratio < 1 - tolerance;
+        regressions += regressed;
+        printf("%-24s %10.3f %10.3f %+8.1f%%%s\n", result.name.c_str(), it->second, result.gbps, (ratio - 1) * 100,
+            regressed ? "  REGRESSION" : "");
+    }
+    return regressions ? EXIT_FAILURE : EXIT_SUCCESS;
+}
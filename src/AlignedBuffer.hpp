@@ -0,0 +1,165 @@
+/**
+ * \file AlignedBuffer.hpp
+ * \brief Pointer and buffer types that carry their alignment in the type
+ */
+#ifndef __ALIGNED_BUFFER_HPP__
+#define __ALIGNED_BUFFER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Pointer to a buffer aligned on Align bytes.
+ *
+ * The alignment is checked once, when the pointer is created with CHECK(), then carried by the type.
+ * BigEndian and LittleEndian overloads that take a BasicAlignedPtr don't test the alignment at runtime.
+ * Use AlignedPtr<Align> for a writable buffer and AlignedConstPtr<Align> for a read only one.
+ */
+template<size_t Align, typename Byte>
+class BasicAlignedPtr
+{
+    static_assert(Align && (Align & (Align - 1)) == 0, "Alignment must be a power of 2");
+    static_assert(sizeof(Byte) == 1, "Byte must be uint8_t or const uint8_t");
+
+public:
+    /** Alignment guaranteed by this pointer (in bytes) */
+    static const size_t ALIGNMENT = Align;
+
+    /** Alignment of ptr + offset when ptr is aligned on align bytes */
+    static constexpr size_t ALIGNMENT_AFTER(const size_t align, const size_t offset)
+    {
+        return offset == 0 ? align : ((offset & (~offset + 1)) < align ? (offset & (~offset + 1)) : align);
+    }
+
+    /** Null pointer */
+    BasicAlignedPtr() : _ptr(nullptr) {}
+
+    /** Convert from a pointer with a stronger alignment, or from a writable to a read only pointer */
+    template<size_t OtherAlign, typename OtherByte,
+        typename = typename std::enable_if<(OtherAlign >= Align) && std::is_convertible<OtherByte*, Byte*>::value>::type>
+    BasicAlignedPtr(const BasicAlignedPtr<OtherAlign, OtherByte>& other) : _ptr(other.get()) {}
+
+    /** True if ptr is aligned on Align bytes */
+    static bool IS_ALIGNED(const uint8_t* ptr) { return uintptr_t(ptr) % Align == 0; }
+
+    /**
+     * \brief Create an aligned pointer after checking the alignment of ptr
+     * \return A null pointer if ptr is not aligned on Align bytes
+     */
+    static BasicAlignedPtr CHECK(Byte* ptr) { return IS_ALIGNED(ptr) ? BasicAlignedPtr(ptr) : BasicAlignedPtr(); }
+
+    /** Create an aligned pointer without any check. ptr must be aligned on Align bytes */
+    static BasicAlignedPtr UNCHECKED(Byte* ptr) { return BasicAlignedPtr(ptr); }
+
+    /** Underlying pointer */
+    Byte* get() const { return _ptr; }
+    /** True if the pointer is null */
+    bool isNull() const { return _ptr == nullptr; }
+
+    /** Pointer Offset bytes further, with the alignment that is still guaranteed */
+    template<size_t Offset>
+    BasicAlignedPtr<ALIGNMENT_AFTER(Align, Offset), Byte> offset() const
+    {
+        return BasicAlignedPtr<ALIGNMENT_AFTER(Align, Offset), Byte>::UNCHECKED(_ptr + Offset);
+    }
+
+    /** Pointer count * Align bytes further, that keep the same alignment */
+    BasicAlignedPtr advance(const size_t count) const { return BasicAlignedPtr(_ptr + count * Align); }
+
+private:
+    explicit BasicAlignedPtr(Byte* ptr) : _ptr(ptr) {}
+
+    Byte* _ptr;
+};
+
+/** Writable buffer aligned on Align bytes */
+template<size_t Align>
+using AlignedPtr = BasicAlignedPtr<Align, uint8_t>;
+
+/** Read only buffer aligned on Align bytes */
+template<size_t Align>
+using AlignedConstPtr = BasicAlignedPtr<Align, const uint8_t>;
+
+/** \brief Heap buffer whose first byte is aligned on Align bytes. Zero initialized. */
+template<size_t Align>
+class AlignedBuffer
+{
+    static_assert(Align && (Align & (Align - 1)) == 0, "Alignment must be a power of 2");
+
+public:
+    /** \param size Size of the buffer (in bytes) */
+    explicit AlignedBuffer(const size_t size = 0) : _storage(nullptr), _data(nullptr), _size(0) { resize(size); }
+    ~AlignedBuffer() { delete[] _storage; }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    AlignedBuffer(AlignedBuffer&& other) : _storage(other._storage), _data(other._data), _size(other._size)
+    {
+        other._storage = other._data = nullptr;
+        other._size = 0;
+    }
+    AlignedBuffer& operator=(AlignedBuffer&& other)
+    {
+        if(this != &other)
+        {
+            delete[] _storage;
+            _storage = other._storage;
+            _data = other._data;
+            _size = other._size;
+            other._storage = other._data = nullptr;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    /** Reallocate the buffer. Content is lost and zeroed */
+    void resize(const size_t size)
+    {
+        delete[] _storage;
+        _storage = _data = nullptr;
+        _size = size;
+        if(!size)
+            return;
+        _storage = new uint8_t[size + Align - 1];
+        const uintptr_t misalignment = uintptr_t(_storage) % Align;
+        _data = _storage + (misalignment ? Align - misalignment : 0);
+        memset(_data, 0, size);
+    }
+
+    /** Aligned pointer to the first byte */
+    AlignedPtr<Align> data() { return AlignedPtr<Align>::UNCHECKED(_data); }
+    /** Aligned pointer to the first byte */
+    AlignedConstPtr<Align> data() const { return AlignedConstPtr<Align>::UNCHECKED(_data); }
+    /** Size of the buffer (in bytes) */
+    size_t size() const { return _size; }
+
+private:
+    uint8_t* _storage;
+    uint8_t* _data;
+    size_t _size;
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
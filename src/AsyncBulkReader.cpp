@@ -0,0 +1,368 @@
+#include <AsyncBulkReader.hpp>
+
+#include <vector>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+
+#include <unistd.h>
+
+#ifdef LIBENDIAN_ENABLE_IO_URING
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+LIBENDIAN_USING_NAMESPACE;
+
+// ─────────────────────────────────────────────────────────────
+//                  PRIVATE
+// ─────────────────────────────────────────────────────────────
+
+struct AsyncBulkReader::Private
+{
+    /** A read in flight, with the buffer it is read into */
+    struct Slot
+    {
+        const ReadRequest* request = nullptr;
+        size_t done = 0;
+        std::vector<uint8_t> buffer;
+    };
+
+    unsigned queueDepth = 0;
+    std::vector<Slot> slots;
+
+#ifdef LIBENDIAN_ENABLE_IO_URING
+    int ringFd = -1;
+
+    void* sqRing = nullptr;
+    size_t sqRingSize = 0;
+    void* cqRing = nullptr;
+    size_t cqRingSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned sqMask = 0;
+    unsigned* sqArray = nullptr;
+
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    bool setup()
+    {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        const long fd = syscall(__NR_io_uring_setup, queueDepth, &params);
+        if(fd < 0)
+            return false;
+        ringFd = int(fd);
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if(singleMmap)
+            sqRingSize = cqRingSize = sqRingSize > cqRingSize ? sqRingSize : cqRingSize;
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if(sqRing == MAP_FAILED)
+        {
+            sqRing = nullptr;
+            teardown();
+            return false;
+        }
+        if(singleMmap)
+            cqRing = sqRing;
+        else
+        {
+            cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+            if(cqRing == MAP_FAILED)
+            {
+                cqRing = nullptr;
+                teardown();
+                return false;
+            }
+        }
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqesPtr = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if(sqesPtr == MAP_FAILED)
+        {
+            teardown();
+            return false;
+        }
+        sqes = static_cast<io_uring_sqe*>(sqesPtr);
+
+        uint8_t* sq = static_cast<uint8_t*>(sqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        uint8_t* cq = static_cast<uint8_t*>(cqRing);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // The kernel may round the number of entries, never have more reads in flight than sqes
+        if(params.sq_entries < queueDepth)
+            queueDepth = params.sq_entries;
+        return true;
+    }
+
+    void teardown()
+    {
+        if(sqes)
+            munmap(sqes, sqesSize);
+        if(cqRing && cqRing != sqRing)
+            munmap(cqRing, cqRingSize);
+        if(sqRing)
+            munmap(sqRing, sqRingSize);
+        if(ringFd >= 0)
+            close(ringFd);
+        sqes = nullptr;
+        cqRing = sqRing = nullptr;
+        ringFd = -1;
+    }
+
+    /** Queue the remaining part of the read of slot. Only the userspace tail is touched, enter() submit */
+    void queueRead(const unsigned slotIndex)
+    {
+        Slot& slot = slots[slotIndex];
+        const unsigned tail = *sqTail;
+        const unsigned index = tail & sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = slot.request->fd;
+        sqe->off = slot.request->offset + slot.done;
+        sqe->addr = uint64_t(uintptr_t(slot.buffer.data() + slot.done));
+        // len is 32 bits: bigger reads are split, the short read handling ask for the rest
+        const size_t remaining = slot.request->length - slot.done;
+        sqe->len = remaining > UINT_MAX ? UINT_MAX : unsigned(remaining);
+        sqe->user_data = slotIndex;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    }
+
+    /** Submit toSubmit sqes and wait for minComplete cqes. toSubmit is decremented by the number of submitted sqes */
+    int enter(unsigned& toSubmit, const unsigned minComplete)
+    {
+        for(;;)
+        {
+            const long ret = syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if(ret >= 0)
+            {
+                toSubmit -= unsigned(ret);
+                return 0;
+            }
+            if(errno != EINTR)
+                return errno;
+        }
+    }
+
+    /**
+     * \brief Forget the reads in flight after enter() or the callback failed, so their cqes don't reach the next readAll().
+     * The sqes the kernel didn't take are removed from the ring, the cqes of the others are reaped and dropped.
+     * If waiting for them fail too, the ring is closed and the next readAll() use pread.
+     */
+    void abandon(const unsigned inFlight)
+    {
+        const unsigned tail = *sqTail;
+        const unsigned unsubmitted = tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        __atomic_store_n(sqTail, tail - unsubmitted, __ATOMIC_RELEASE);
+
+        // A slot has either a sqe waiting in the ring or a read in the kernel
+        unsigned outstanding = inFlight - unsubmitted;
+        while(outstanding)
+        {
+            unsigned none = 0;
+            if(enter(none, 1))
+            {
+                teardown();
+                return;
+            }
+            const unsigned head = *cqHead;
+            const unsigned cqTailNow = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+            outstanding -= cqTailNow - head;
+            __atomic_store_n(cqHead, cqTailNow, __ATOMIC_RELEASE);
+        }
+    }
+
+    int readAllIoUring(const ReadRequest* requests, const size_t count, const Callback& callback)
+    {
+        std::vector<unsigned> freeSlots;
+        for(unsigned i = queueDepth; i > 0; --i)
+            freeSlots.push_back(i - 1);
+
+        int firstError = 0;
+        size_t next = 0;
+        unsigned inFlight = 0;
+        unsigned toSubmit = 0;
+
+        while(next < count || inFlight)
+        {
+            while(next < count && !freeSlots.empty())
+            {
+                const ReadRequest& request = requests[next++];
+                if(!request.length)
+                {
+                    try
+                    {
+                        callback(request, nullptr, 0, 0);
+                    }
+                    catch(...)
+                    {
+                        abandon(inFlight);
+                        throw;
+                    }
+                    continue;
+                }
+                const unsigned slotIndex = freeSlots.back();
+                freeSlots.pop_back();
+                Slot& slot = slots[slotIndex];
+                slot.request = &request;
+                slot.done = 0;
+                if(slot.buffer.size() < request.length)
+                    slot.buffer.resize(request.length);
+                queueRead(slotIndex);
+                ++toSubmit;
+                ++inFlight;
+            }
+
+            const int error = enter(toSubmit, inFlight ? 1 : 0);
+            if(error)
+            {
+                abandon(inFlight);
+                return error;
+            }
+
+            unsigned head = *cqHead;
+            const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+            for(; head != tail; ++head)
+            {
+                const io_uring_cqe& cqe = cqes[head & cqMask];
+                const unsigned slotIndex = unsigned(cqe.user_data);
+                Slot& slot = slots[slotIndex];
+                const int res = cqe.res;
+
+                if(res == -EINTR || res == -EAGAIN)
+                {
+                    queueRead(slotIndex);
+                    ++toSubmit;
+                    continue;
+                }
+                if(res > 0)
+                {
+                    slot.done += size_t(res);
+                    // Short read: ask for the rest
+                    if(slot.done < slot.request->length)
+                    {
+                        queueRead(slotIndex);
+                        ++toSubmit;
+                        continue;
+                    }
+                }
+                const int readError = res < 0 ? -res : 0;
+                if(readError && !firstError)
+                    firstError = readError;
+                freeSlots.push_back(slotIndex);
+                --inFlight;
+                try
+                {
+                    callback(*slot.request, slot.buffer.data(), slot.done, readError);
+                }
+                catch(...)
+                {
+                    // This cqe is consumed, the ones after it are reaped by abandon()
+                    __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+                    abandon(inFlight);
+                    throw;
+                }
+            }
+            __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        }
+        return firstError;
+    }
+#endif
+
+    int readAllPread(const ReadRequest* requests, const size_t count, const Callback& callback)
+    {
+        int firstError = 0;
+        Slot& slot = slots[0];
+        for(size_t i = 0; i < count; ++i)
+        {
+            const ReadRequest& request = requests[i];
+            if(slot.buffer.size() < request.length)
+                slot.buffer.resize(request.length);
+            slot.done = 0;
+            int readError = 0;
+            while(slot.done < request.length)
+            {
+                const ssize_t res = pread(request.fd, slot.buffer.data() + slot.done,
+                    request.length - slot.done, off_t(request.offset + slot.done));
+                if(res < 0 && errno == EINTR)
+                    continue;
+                if(res < 0)
+                {
+                    readError = errno;
+                    break;
+                }
+                if(res == 0)
+                    break;
+                slot.done += size_t(res);
+            }
+            if(readError && !firstError)
+                firstError = readError;
+            callback(request, slot.buffer.data(), slot.done, readError);
+        }
+        return firstError;
+    }
+};
+
+// ─────────────────────────────────────────────────────────────
+//                  PUBLIC
+// ─────────────────────────────────────────────────────────────
+
+AsyncBulkReader::AsyncBulkReader(const unsigned queueDepth) : _d(new Private)
+{
+    _d->queueDepth = queueDepth ? queueDepth : 1;
+#ifdef LIBENDIAN_ENABLE_IO_URING
+    _d->setup();
+#endif
+    _d->slots.resize(_d->queueDepth);
+}
+
+AsyncBulkReader::~AsyncBulkReader()
+{
+#ifdef LIBENDIAN_ENABLE_IO_URING
+    _d->teardown();
+#endif
+    delete _d;
+}
+
+bool AsyncBulkReader::isIoUring() const
+{
+#ifdef LIBENDIAN_ENABLE_IO_URING
+    return _d->ringFd >= 0;
+#else
+    return false;
+#endif
+}
+
+unsigned AsyncBulkReader::queueDepth() const
+{
+    return _d->queueDepth;
+}
+
+int AsyncBulkReader::readAll(const ReadRequest* requests, const size_t count, const Callback& callback)
+{
+#ifdef LIBENDIAN_ENABLE_IO_URING
+    if(_d->ringFd >= 0)
+        return _d->readAllIoUring(requests, count, callback);
+#endif
+    return _d->readAllPread(requests, count, callback);
+}
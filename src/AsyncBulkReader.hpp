@@ -0,0 +1,93 @@
+/**
+ * \file AsyncBulkReader.hpp
+ * \brief Read many file ranges concurrently and hand them to a decode callback
+ */
+#ifndef __ASYNC_BULK_READER_HPP__
+#define __ASYNC_BULK_READER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/** \brief A range of a file to read */
+struct LIBENDIAN_API_ ReadRequest
+{
+    /** Opened file descriptor to read from */
+    int fd;
+    /** Offset in the file (in bytes) */
+    uint64_t offset;
+    /** Number of bytes to read */
+    size_t length;
+    /** Forwarded untouched to the callback */
+    void* userData;
+};
+
+/**
+ * \brief Keep up to queueDepth reads in flight and deliver each completed buffer to a callback.
+ *
+ * On Linux, when the library is built with LIBENDIAN_ENABLE_IO_URING and the kernel allow it,
+ * reads are submitted to an io_uring so storage latency is hidden behind decoding
+ * without a thread per file. Otherwise requests are served one after the other with pread.
+ */
+class LIBENDIAN_API_ AsyncBulkReader
+{
+public:
+    /**
+     * \brief Called once per request, from the thread that called readAll.
+     * data is only valid until the callback return, the buffer is then reused for another read.
+     * error is 0 on success or an errno value. length is smaller than requested if the end of file was reached.
+     * An exception thrown by the callback leave readAll once the other reads in flight are dropped.
+     */
+    typedef std::function<void(const ReadRequest& request, const uint8_t* data, size_t length, int error)> Callback;
+
+    /**
+     * \brief Create the reader and try to setup an io_uring
+     * \param queueDepth Maximum number of reads in flight
+     */
+    explicit AsyncBulkReader(const unsigned queueDepth = 32);
+    ~AsyncBulkReader();
+
+    AsyncBulkReader(const AsyncBulkReader&) = delete;
+    AsyncBulkReader& operator=(const AsyncBulkReader&) = delete;
+
+    /** True if reads are performed with io_uring, false if pread is used */
+    bool isIoUring() const;
+    /** Maximum number of reads in flight */
+    unsigned queueDepth() const;
+
+    /**
+     * \brief Read every request and call callback as soon as each one complete.
+     * Completion order is not the submission order.
+     * \param requests Array of requests
+     * \param count Number of requests
+     * \param callback Invoked once per request
+     * \return 0 on success, or the errno of the first failure
+     */
+    int readAll(const ReadRequest* requests, const size_t count, const Callback& callback);
+
+private:
+    struct Private;
+    Private* _d;
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
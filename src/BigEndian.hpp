@@ -12,6 +12,8 @@
 // Application Header
 #include <LibEndian.hpp>
 #include <EndianHelpers.hpp>
+#include <AlignedBuffer.hpp>
+#include <BulkSwap.hpp>
 
 // C++ Header
 #include <cstdint>
@@ -32,6 +34,15 @@ LIBENDIAN_NAMESPACE_START
 class LIBENDIAN_API_ BigEndian : public LibEndian
 {
 public:
+    /** Byte order of this class, for generic code that select its kernels at compile time */
+    static const bool IS_BIG_ORDER = true;
+    /** True if this byte order is the one of the host: conversions are plain copies */
+#ifdef LIBENDIAN_IS_BIG_ENDIAN
+    static const bool IS_HOST_ORDER = true;
+#else
+    static const bool IS_HOST_ORDER = false;
+#endif
+
     /**
      * \brief Deserialize an uint8_t from buffer
      * \param buf Pointer to the uint8_t
@@ -55,7 +66,7 @@ public:
                 return uint16_t(*(const uint16_t*)(buf));
           #else
             if(IS_16_ALIGNED(uintptr_t(buf)))
-                return bswap_16(uint16_t(*buf));
+                return bswap_16(*(const uint16_t*)(buf));
           #endif
         #endif
         return ((uint16_t)buf[0] << 8) |
@@ -75,7 +86,7 @@ public:
                 return uint32_t(*(const uint32_t*)(buf));
           #else
             if(IS_32_ALIGNED(uintptr_t(buf)))
-                return bswap_32(uint32_t(*buf));
+                return bswap_32(*(const uint32_t*)(buf));
           #endif
         #endif
         return ((uint32_t)buf[0] << 24) |
@@ -92,15 +103,6 @@ public:
      */
     static uint64_t GET_UINT48(const uint8_t* buf)
     {
-        #ifdef LIBENDIAN_ENABLE_BSWAP
-          #ifdef LIBENDIAN_IS_BIG_ENDIAN
-            if(IS_64_ALIGNED(uintptr_t(buf)))
-                return uint64_t(*(const uint64_t*)(buf)) & uint64_t(0xFFFFFFFFFFFF);
-          #else
-            if(IS_64_ALIGNED(uintptr_t(buf)))
-                return bswap_64(uint64_t(*buf)) & uint64_t(0xFFFFFFFFFFFF);
-          #endif
-        #endif
         return ((uint64_t)buf[0] << 40) |
                ((uint64_t)buf[1] << 32) |
                ((uint64_t)buf[2] << 24) |
@@ -122,7 +124,7 @@ public:
                 return uint64_t(*(const uint64_t*)(buf));
           #else
             if(IS_64_ALIGNED(uintptr_t(buf)))
-                return bswap_64(uint64_t(*buf));
+                return bswap_64(*(const uint64_t*)(buf));
           #endif
         #endif
         return ((uint64_t)buf[0] << 56) |
@@ -153,7 +155,7 @@ public:
      */
     static int16_t GET_INT16(const uint8_t* buf)
     {
-        const uint8_t value = GET_UINT8(buf);
+        const uint16_t value = GET_UINT16(buf);
         return *(int16_t*)(&value);
     }
 
@@ -164,7 +166,7 @@ public:
      */
     static int32_t GET_INT32(const uint8_t* buf)
     {
-        const uint8_t value = GET_UINT8(buf);
+        const uint32_t value = GET_UINT32(buf);
         return *(int32_t*)(&value);
     }
 
@@ -176,7 +178,10 @@ public:
      */
     static int64_t GET_INT48(const uint8_t* buf)
     {
-        const uint8_t value = GET_UINT8(buf);
+        uint64_t value = GET_UINT48(buf);
+        // Sign extend bit 47 to the upper 16 bits
+        if(value & uint64_t(0x800000000000))
+            value |= uint64_t(0xFFFF000000000000);
         return *(int64_t*)(&value);
     }
 
@@ -187,7 +192,7 @@ public:
      */
     static int64_t GET_INT64(const uint8_t* buf)
     {
-        const uint8_t value = GET_UINT8(buf);
+        const uint64_t value = GET_UINT64(buf);
         return *(int64_t*)(&value);
     }
 
@@ -383,21 +388,6 @@ public:
      */
     static void SET_UINT48(uint8_t* buf, const uint64_t val)
     {
-        #ifdef LIBENDIAN_ENABLE_BSWAP
-          #ifdef LIBENDIAN_IS_BIG_ENDIAN
-            if(IS_64_ALIGNED(uintptr_t(buf)))
-            {
-                (*(uint64_t*)buf) = val & uint64_t(0xFFFFFFFFFFFF);
-                return;
-            }
-          #else
-            if(IS_64_ALIGNED(uintptr_t(buf)))
-            {
-                (*(uint64_t*)buf) = bswap_64(val) & uint64_t(0xFFFFFFFFFFFF);
-                return;
-            }
-          #endif
-        #endif
         buf[0] = (uint8_t)((val >> 40) & 0xFF);
         buf[1] = (uint8_t)((val >> 32) & 0xFF);
         buf[2] = (uint8_t)((val >> 24) & 0xFF);
@@ -702,21 +692,15 @@ public:
      * \param dest ptr to local uint16_t buffer, that contains uint16_t
      * \param src ptr to big endian buffer of uint16_t that need to be deserialized in dest
      * \param count Number of uint16_t in src
+     * \param mode Select cached or non-temporal stores. See StoreMode
      */
-    static void MEMCPY_16(uint8_t* dest, const uint8_t* src, const size_t count)
+    static void MEMCPY_16(uint8_t* dest, const uint8_t* src, const size_t count, const StoreMode mode = STORE_AUTO)
     {
         #ifndef LIBENDIAN_IS_BIG_ENDIAN
-        if(IS_16_ALIGNED(src))
-        {
-            for (int i = 0; i < count; i += 2)
-                *reinterpret_cast<uint16_t*>(&dest[i]) = GET_UINT16(src, i);
-            return;
-        }
+        BulkSwap::SWAP_16(dest, src, count, mode);
+        #else
+        BulkSwap::COPY(dest, src, count * 2, mode);
         #endif
-        if(OVERLAP(uintptr_t(dest), uintptr_t(src), count * 2))
-            memmove(dest, src, count * 2);
-        else
-            memcpy(dest, src, count * 2);
     }
 
     /**
@@ -724,21 +708,15 @@ public:
      * \param dest ptr to local uint32_t buffer, that contains uint32_t
      * \param src ptr to big endian buffer of uint32_t that need to be deserialized in dest
      * \param count Number of uint32_t in src
+     * \param mode Select cached or non-temporal stores. See StoreMode
      */
-    static void MEMCPY_32(uint8_t* dest, const uint8_t* src, const size_t count)
+    static void MEMCPY_32(uint8_t* dest, const uint8_t* src, const size_t count, const StoreMode mode = STORE_AUTO)
     {
         #ifndef LIBENDIAN_IS_BIG_ENDIAN
-        if(IS_32_ALIGNED(src))
-        {
-            for (int i = 0; i < count; i += 4)
-                *reinterpret_cast<uint32_t*>(&dest[i]) = GET_UINT32(src, i);
-            return;
-        }
+        BulkSwap::SWAP_32(dest, src, count, mode);
+        #else
+        BulkSwap::COPY(dest, src, count * 4, mode);
         #endif
-        if(OVERLAP(uintptr_t(dest), uintptr_t(src), count * 4))
-            memmove(dest, src, count * 4);
-        else
-            memcpy(dest, src, count * 4);
     }
 
     /**
@@ -746,23 +724,49 @@ public:
      * \param dest ptr to local uint64_t buffer, that contains uint64_t
      * \param src ptr to big endian buffer of uint64_t that need to be deserialized in dest
      * \param count Number of uint64_t in src
+     * \param mode Select cached or non-temporal stores. See StoreMode
      */
-    static void MEMCPY_64(uint8_t* dest, const uint8_t* src, const size_t count)
+    static void MEMCPY_64(uint8_t* dest, const uint8_t* src, const size_t count, const StoreMode mode = STORE_AUTO)
     {
         #ifndef LIBENDIAN_IS_BIG_ENDIAN
-        if(IS_64_ALIGNED(src))
-        {
-            for (int i = 0; i < count; i += 8)
-                *reinterpret_cast<uint64_t*>(&dest[i]) = GET_UINT64(src, i);
-            return;
-        }
+        BulkSwap::SWAP_64(dest, src, count, mode);
+        #else
+        BulkSwap::COPY(dest, src, count * 8, mode);
         #endif
-        if(OVERLAP(uintptr_t(dest), uintptr_t(src), count * 8))
-            memmove(dest, src, count * 8);
-        else
-            memcpy(dest, src, count * 8);
     }
 
+    /**
+     * \brief Deserialize count uint48_t packed every 6 bytes
+     * \param dest Receive count values, zero extended to uint64_t
+     * \param src Pointer to count * UINT48_SIZE bytes
+     * \param count Number of uint48_t in src
+     */
+    static void GET_UINT48_ARRAY(uint64_t* dest, const uint8_t* src, const size_t count) { BulkSwap::UNPACK_48<true, false>(dest, src, count); }
+
+    /**
+     * \brief Deserialize count int48_t packed every 6 bytes
+     * \param dest Receive count values, sign extended to int64_t
+     * \param src Pointer to count * INT48_SIZE bytes
+     * \param count Number of int48_t in src
+     */
+    static void GET_INT48_ARRAY(int64_t* dest, const uint8_t* src, const size_t count) { BulkSwap::UNPACK_48<true, true>((uint64_t*)dest, src, count); }
+
+    /**
+     * \brief Serialize count uint48_t packed every 6 bytes
+     * \param dest Pointer to count * UINT48_SIZE bytes
+     * \param src Values to serialize, only the 48 low bits are kept
+     * \param count Number of values in src
+     */
+    static void SET_UINT48_ARRAY(uint8_t* dest, const uint64_t* src, const size_t count) { BulkSwap::PACK_48<true>(dest, src, count); }
+
+    /**
+     * \brief Serialize count int48_t packed every 6 bytes
+     * \param dest Pointer to count * INT48_SIZE bytes
+     * \param src Values to serialize, must be in the int48_t range
+     * \param count Number of values in src
+     */
+    static void SET_INT48_ARRAY(uint8_t* dest, const int64_t* src, const size_t count) { BulkSwap::PACK_48<true>(dest, (const uint64_t*)src, count); }
+
     /**
      * \brief Deserialize an uint8_t from buffer
      * \param buf Pointer to the uint8_t
@@ -817,7 +821,7 @@ public:
      */
     static int16_t GET_INT16(const char* buf)
     {
-        const uint8_t value = GET_UINT8(buf);
+        const uint16_t value = GET_UINT16(buf);
         return *(int16_t*)(&value);
     }
 
@@ -828,7 +832,7 @@ public:
      */
     static int32_t GET_INT32(const char* buf)
     {
-        const uint8_t value = GET_UINT8(buf);
+        const uint32_t value = GET_UINT32(buf);
         return *(int32_t*)(&value);
     }
 
@@ -840,7 +844,10 @@ public:
      */
     static int64_t GET_INT48(const char* buf)
     {
-        const uint8_t value = GET_UINT8(buf);
+        uint64_t value = GET_UINT48(buf);
+        // Sign extend bit 47 to the upper 16 bits
+        if(value & uint64_t(0x800000000000))
+            value |= uint64_t(0xFFFF000000000000);
         return *(int64_t*)(&value);
     }
 
@@ -851,7 +858,7 @@ public:
      */
     static int64_t GET_INT64(const char* buf)
     {
-        const uint8_t value = GET_UINT8(buf);
+        const uint64_t value = GET_UINT64(buf);
         return *(int64_t*)(&value);
     }
 
@@ -1274,10 +1281,11 @@ public:
      * \param dest ptr to local uint16_t buffer, that contains uint16_t
      * \param src ptr to big endian buffer of uint16_t that need to be deserialized in dest
      * \param count Number of uint16_t in src
+     * \param mode Select cached or non-temporal stores. See StoreMode
      */
-    static void MEMCPY_16(char* dest, const char* src, const size_t count)
+    static void MEMCPY_16(char* dest, const char* src, const size_t count, const StoreMode mode = STORE_AUTO)
     {
-        MEMCPY_16((uint8_t*)dest, (const uint8_t*)src, count);
+        MEMCPY_16((uint8_t*)dest, (const uint8_t*)src, count, mode);
     }
 
     /**
@@ -1285,10 +1293,11 @@ public:
      * \param dest ptr to local uint32_t buffer, that contains uint32_t
      * \param src ptr to big endian buffer of uint32_t that need to be deserialized in dest
      * \param count Number of uint32_t in src
+     * \param mode Select cached or non-temporal stores. See StoreMode
      */
-    static void MEMCPY_32(char* dest, const char* src, const size_t count)
+    static void MEMCPY_32(char* dest, const char* src, const size_t count, const StoreMode mode = STORE_AUTO)
     {
-        MEMCPY_32((uint8_t*)dest, (const uint8_t*)src, count);
+        MEMCPY_32((uint8_t*)dest, (const uint8_t*)src, count, mode);
     }
 
     /**
@@ -1296,10 +1305,233 @@ public:
      * \param dest ptr to local uint64_t buffer, that contains uint64_t
      * \param src ptr to big endian buffer of uint64_t that need to be deserialized in dest
      * \param count Number of uint64_t in src
+     * \param mode Select cached or non-temporal stores. See StoreMode
+     */
+    static void MEMCPY_64(char* dest, const char* src, const size_t count, const StoreMode mode = STORE_AUTO)
+    {
+        MEMCPY_64((uint8_t*)dest, (const uint8_t*)src, count, mode);
+    }
+
+    /**
+     * \brief Deserialize an uint16_t from an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the uint16_t, aligned on at least 2 bytes
+     * \return The deserialized data
+     */
+    template<size_t Align, typename Byte>
+    static uint16_t GET_UINT16(const BasicAlignedPtr<Align, Byte> buf)
+    {
+        static_assert(Align >= UINT16_SIZE, "Buffer must be aligned on the size of uint16_t");
+        #ifdef LIBENDIAN_ENABLE_BSWAP
+          #ifdef LIBENDIAN_IS_BIG_ENDIAN
+            return *(const uint16_t*)(buf.get());
+          #else
+            return bswap_16(*(const uint16_t*)(buf.get()));
+          #endif
+        #else
+        return GET_UINT16((const uint8_t*)buf.get());
+        #endif
+    }
+
+    /**
+     * \brief Deserialize an uint32_t from an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the uint32_t, aligned on at least 4 bytes
+     * \return The deserialized data
+     */
+    template<size_t Align, typename Byte>
+    static uint32_t GET_UINT32(const BasicAlignedPtr<Align, Byte> buf)
+    {
+        static_assert(Align >= UINT32_SIZE, "Buffer must be aligned on the size of uint32_t");
+        #ifdef LIBENDIAN_ENABLE_BSWAP
+          #ifdef LIBENDIAN_IS_BIG_ENDIAN
+            return *(const uint32_t*)(buf.get());
+          #else
+            return bswap_32(*(const uint32_t*)(buf.get()));
+          #endif
+        #else
+        return GET_UINT32((const uint8_t*)buf.get());
+        #endif
+    }
+
+    /**
+     * \brief Deserialize an uint64_t from an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the uint64_t, aligned on at least 8 bytes
+     * \return The deserialized data
+     */
+    template<size_t Align, typename Byte>
+    static uint64_t GET_UINT64(const BasicAlignedPtr<Align, Byte> buf)
+    {
+        static_assert(Align >= UINT64_SIZE, "Buffer must be aligned on the size of uint64_t");
+        #ifdef LIBENDIAN_ENABLE_BSWAP
+          #ifdef LIBENDIAN_IS_BIG_ENDIAN
+            return *(const uint64_t*)(buf.get());
+          #else
+            return bswap_64(*(const uint64_t*)(buf.get()));
+          #endif
+        #else
+        return GET_UINT64((const uint8_t*)buf.get());
+        #endif
+    }
+
+    /**
+     * \brief Deserialize an int16_t from an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the int16_t, aligned on at least 2 bytes
+     * \return The deserialized data
+     */
+    template<size_t Align, typename Byte>
+    static int16_t GET_INT16(const BasicAlignedPtr<Align, Byte> buf) { return int16_t(GET_UINT16(buf)); }
+
+    /**
+     * \brief Deserialize an int32_t from an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the int32_t, aligned on at least 4 bytes
+     * \return The deserialized data
+     */
+    template<size_t Align, typename Byte>
+    static int32_t GET_INT32(const BasicAlignedPtr<Align, Byte> buf) { return int32_t(GET_UINT32(buf)); }
+
+    /**
+     * \brief Deserialize an int64_t from an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the int64_t, aligned on at least 8 bytes
+     * \return The deserialized data
+     */
+    template<size_t Align, typename Byte>
+    static int64_t GET_INT64(const BasicAlignedPtr<Align, Byte> buf) { return int64_t(GET_UINT64(buf)); }
+
+    /**
+     * \brief Deserialize a float from an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the float, aligned on at least 4 bytes
+     * \return The deserialized data
+     */
+    template<size_t Align, typename Byte>
+    static float GET_FLOAT32(const BasicAlignedPtr<Align, Byte> buf)
+    {
+        const uint32_t value = GET_UINT32(buf);
+        float result;
+        memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+
+    /**
+     * \brief Deserialize a double from an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the double, aligned on at least 8 bytes
+     * \return The deserialized data
+     */
+    template<size_t Align, typename Byte>
+    static double GET_FLOAT64(const BasicAlignedPtr<Align, Byte> buf)
+    {
+        const uint64_t value = GET_UINT64(buf);
+        double result;
+        memcpy(&result, &value, sizeof(result));
+        return result;
+    }
+
+    /**
+     * \brief Serialize a uint16_t in an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the buffer, aligned on at least 2 bytes
+     * \param val Value to serialize
+     */
+    template<size_t Align>
+    static void SET_UINT16(const AlignedPtr<Align> buf, const uint16_t val)
+    {
+        static_assert(Align >= UINT16_SIZE, "Buffer must be aligned on the size of uint16_t");
+        #ifdef LIBENDIAN_ENABLE_BSWAP
+          #ifdef LIBENDIAN_IS_BIG_ENDIAN
+            (*(uint16_t*)buf.get()) = val;
+          #else
+            (*(uint16_t*)buf.get()) = bswap_16(val);
+          #endif
+        #else
+        SET_UINT16(buf.get(), val);
+        #endif
+    }
+
+    /**
+     * \brief Serialize a uint32_t in an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the buffer, aligned on at least 4 bytes
+     * \param val Value to serialize
+     */
+    template<size_t Align>
+    static void SET_UINT32(const AlignedPtr<Align> buf, const uint32_t val)
+    {
+        static_assert(Align >= UINT32_SIZE, "Buffer must be aligned on the size of uint32_t");
+        #ifdef LIBENDIAN_ENABLE_BSWAP
+          #ifdef LIBENDIAN_IS_BIG_ENDIAN
+            (*(uint32_t*)buf.get()) = val;
+          #else
+            (*(uint32_t*)buf.get()) = bswap_32(val);
+          #endif
+        #else
+        SET_UINT32(buf.get(), val);
+        #endif
+    }
+
+    /**
+     * \brief Serialize a uint64_t in an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the buffer, aligned on at least 8 bytes
+     * \param val Value to serialize
+     */
+    template<size_t Align>
+    static void SET_UINT64(const AlignedPtr<Align> buf, const uint64_t val)
+    {
+        static_assert(Align >= UINT64_SIZE, "Buffer must be aligned on the size of uint64_t");
+        #ifdef LIBENDIAN_ENABLE_BSWAP
+          #ifdef LIBENDIAN_IS_BIG_ENDIAN
+            (*(uint64_t*)buf.get()) = val;
+          #else
+            (*(uint64_t*)buf.get()) = bswap_64(val);
+          #endif
+        #else
+        SET_UINT64(buf.get(), val);
+        #endif
+    }
+
+    /**
+     * \brief Serialize a int16_t in an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the buffer, aligned on at least 2 bytes
+     * \param val Value to serialize
+     */
+    template<size_t Align>
+    static void SET_INT16(const AlignedPtr<Align> buf, const int16_t val) { SET_UINT16(buf, uint16_t(val)); }
+
+    /**
+     * \brief Serialize a int32_t in an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the buffer, aligned on at least 4 bytes
+     * \param val Value to serialize
+     */
+    template<size_t Align>
+    static void SET_INT32(const AlignedPtr<Align> buf, const int32_t val) { SET_UINT32(buf, uint32_t(val)); }
+
+    /**
+     * \brief Serialize a int64_t in an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the buffer, aligned on at least 8 bytes
+     * \param val Value to serialize
+     */
+    template<size_t Align>
+    static void SET_INT64(const AlignedPtr<Align> buf, const int64_t val) { SET_UINT64(buf, uint64_t(val)); }
+
+    /**
+     * \brief Serialize a float in an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the buffer, aligned on at least 4 bytes
+     * \param val Value to serialize
+     */
+    template<size_t Align>
+    static void SET_FLOAT32(const AlignedPtr<Align> buf, const float val)
+    {
+        uint32_t value;
+        memcpy(&value, &val, sizeof(value));
+        SET_UINT32(buf, value);
+    }
+
+    /**
+     * \brief Serialize a double in an aligned buffer, without runtime alignment check
+     * \param buf Pointer to the buffer, aligned on at least 8 bytes
+     * \param val Value to serialize
      */
-    static void MEMCPY_64(char* dest, const char* src, const size_t count)
+    template<size_t Align>
+    static void SET_FLOAT64(const AlignedPtr<Align> buf, const double val)
     {
-        MEMCPY_64((uint8_t*)dest, (const uint8_t*)src, count);
+        uint64_t value;
+        memcpy(&value, &val, sizeof(value));
+        SET_UINT64(buf, value);
     }
 
 };
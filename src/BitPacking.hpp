@@ -0,0 +1,308 @@
+/**
+ * \file BitPacking.hpp
+ * \brief Pack uint32_t columns on the number of bits they use, 128 values at a time
+ */
+#ifndef __BIT_PACKING_HPP__
+#define __BIT_PACKING_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianSimd.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief SIMD-BP128 bit packing of uint32_t columns.
+ *
+ * Values are split in blocks of BLOCK_SIZE (128). Each block is a UINT8 width (0 to 32), the number of bits
+ * of its biggest value, followed by the packed values. Packing is vertical: value i go to lane i % 4 and every
+ * lane pack its values in consecutive 32 bits words, least significant bits first. The words of the 4 lanes
+ * are interleaved, so a block is an array of 128 bits rows that SSE2 shifts, ors and masks process directly.
+ * Words are serialized with Endian (BigEndian or LittleEndian).
+ *
+ * A full block use 16 * width bytes. The last block hold count % 128 values and only use the rows it needs:
+ * 16 * ceil(ceil(n / 4) * width / 32) bytes. Like DeltaCoding, the number of values isn't stored.
+ */
+template<class Endian>
+class BitPacking : public LibEndian
+{
+public:
+    /** Number of values per block */
+    static const size_t BLOCK_SIZE = 128;
+
+    /** Number of bits used by the biggest of count values, 0 to 32 */
+    static uint8_t WIDTH_FOR(const uint32_t* src, const size_t count)
+    {
+        uint32_t bits = 0;
+        for(size_t i = 0; i < count; ++i)
+            bits |= src[i];
+        uint8_t width = 0;
+        for(; bits; bits >>= 1)
+            ++width;
+        return width;
+    }
+
+    /** Size of a block of count values (at most BLOCK_SIZE) packed on width bits, header excluded */
+    static size_t BLOCK_SIZE_FOR(const size_t count, const uint8_t width)
+    {
+        const size_t rows = (count + 3) / 4;
+        return 16 * ((rows * width + 31) / 32);
+    }
+
+    /** Upper bound of the encoded size of count values, whatever they are */
+    static size_t MAX_ENCODED_SIZE(const size_t count)
+    {
+        const size_t blocks = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        return blocks * (UINT8_SIZE + 16) + count * UINT32_SIZE;
+    }
+
+    /**
+     * \brief Number of bytes written by ENCODE for src
+     * \param src Values to encode
+     * \param count Number of values in src
+     */
+    static size_t ENCODED_SIZE(const uint32_t* src, const size_t count)
+    {
+        size_t size = 0;
+        for(size_t begin = 0; begin < count; begin += BLOCK_SIZE)
+        {
+            const size_t n = count - begin < BLOCK_SIZE ? count - begin : BLOCK_SIZE;
+            size += UINT8_SIZE + BLOCK_SIZE_FOR(n, WIDTH_FOR(src + begin, n));
+        }
+        return size;
+    }
+
+    /**
+     * \brief Bit pack count uint32_t
+     * \param dest Buffer of at least ENCODED_SIZE (or MAX_ENCODED_SIZE) bytes
+     * \param src Values to encode
+     * \param count Number of values in src
+     * \return Number of bytes written in dest
+     */
+    static size_t ENCODE(uint8_t* dest, const uint32_t* src, const size_t count)
+    {
+        uint8_t* out = dest;
+        for(size_t begin = 0; begin < count; begin += BLOCK_SIZE)
+        {
+            const size_t n = count - begin < BLOCK_SIZE ? count - begin : BLOCK_SIZE;
+            const uint8_t width = WIDTH_FOR(src + begin, n);
+            *out++ = width;
+            if(!width)
+                continue;
+
+            // Kernels read whole rows of 4 values, complete the last one with zeros
+            const uint32_t* values = src + begin;
+            uint32_t padded[BLOCK_SIZE];
+            if(n % 4)
+            {
+                memset(padded, 0, sizeof(padded));
+                memcpy(padded, values, n * sizeof(uint32_t));
+                values = padded;
+            }
+
+            const size_t size = BLOCK_SIZE_FOR(n, width);
+            PACKERS[width](out, values, (n + 3) / 4);
+            if(!Endian::IS_HOST_ORDER)
+                Endian::MEMCPY_32(out, out, size / UINT32_SIZE);
+            out += size;
+        }
+        return out - dest;
+    }
+
+    /**
+     * \brief Decode count uint32_t encoded by ENCODE
+     * \param dest Buffer of at least count uint32_t
+     * \param src Encoded buffer
+     * \param count Number of values to decode
+     * \return Number of bytes read from src, 0 if count is 0 or a block width is bigger than 32 (malformed input)
+     */
+    static size_t DECODE(uint32_t* dest, const uint8_t* src, const size_t count)
+    {
+        const uint8_t* in = src;
+        for(size_t begin = 0; begin < count; begin += BLOCK_SIZE)
+        {
+            const size_t n = count - begin < BLOCK_SIZE ? count - begin : BLOCK_SIZE;
+            const uint8_t width = *in++;
+            if(width > 32)
+                return 0;
+            if(!width)
+            {
+                memset(dest + begin, 0, n * sizeof(uint32_t));
+                continue;
+            }
+
+            const size_t size = BLOCK_SIZE_FOR(n, width);
+            const uint8_t* words = in;
+            uint32_t swapped[BLOCK_SIZE];
+            if(!Endian::IS_HOST_ORDER)
+            {
+                Endian::MEMCPY_32(reinterpret_cast<uint8_t*>(swapped), in, size / UINT32_SIZE);
+                words = reinterpret_cast<const uint8_t*>(swapped);
+            }
+
+            // Kernels write whole rows of 4 values, the last one go through a temporary block
+            if(n % 4)
+            {
+                uint32_t values[BLOCK_SIZE];
+                UNPACKERS[width](values, words, (n + 3) / 4);
+                memcpy(dest + begin, values, n * sizeof(uint32_t));
+            }
+            else
+                UNPACKERS[width](dest + begin, words, n / 4);
+            in += size;
+        }
+        return in - src;
+    }
+
+private:
+    typedef void (*Packer)(uint8_t* dest, const uint32_t* src, const size_t rows);
+    typedef void (*Unpacker)(uint32_t* dest, const uint8_t* src, const size_t rows);
+
+    static const Packer PACKERS[33];
+    static const Unpacker UNPACKERS[33];
+
+    /** Pack rows of 4 values on Width bits into native order words */
+    template<int Width>
+    static void PACK(uint8_t* dest, const uint32_t* src, const size_t rows)
+    {
+    #ifdef LIBENDIAN_HAS_SSE2
+        __m128i* out = reinterpret_cast<__m128i*>(dest);
+        __m128i word = _mm_setzero_si128();
+        int shift = 0;
+        for(size_t r = 0; r < rows; ++r)
+        {
+            const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4 * r));
+            if(Width == 32)
+            {
+                _mm_storeu_si128(out++, in);
+                continue;
+            }
+            word = _mm_or_si128(word, _mm_sll_epi32(in, _mm_cvtsi32_si128(shift)));
+            shift += Width;
+            if(shift >= 32)
+            {
+                _mm_storeu_si128(out++, word);
+                shift -= 32;
+                // High bits of the value that didn't fit start the next word
+                word = shift ? _mm_srl_epi32(in, _mm_cvtsi32_si128(Width - shift)) : _mm_setzero_si128();
+            }
+        }
+        if(shift)
+            _mm_storeu_si128(out, word);
+    #else
+        for(int lane = 0; lane < 4; ++lane)
+        {
+            uint8_t* out = dest + lane * UINT32_SIZE;
+            uint32_t word = 0;
+            int shift = 0;
+            for(size_t r = 0; r < rows; ++r)
+            {
+                const uint32_t in = src[4 * r + lane];
+                word |= shift < 32 ? in << shift : 0;
+                shift += Width;
+                if(shift >= 32)
+                {
+                    memcpy(out, &word, UINT32_SIZE);
+                    out += 16;
+                    shift -= 32;
+                    word = shift ? in >> (Width - shift) : 0;
+                }
+            }
+            if(shift)
+                memcpy(out, &word, UINT32_SIZE);
+        }
+    #endif
+    }
+
+    /** Unpack rows of 4 values on Width bits from native order words */
+    template<int Width>
+    static void UNPACK(uint32_t* dest, const uint8_t* src, const size_t rows)
+    {
+        const uint32_t mask = Width == 32 ? uint32_t(0xFFFFFFFF) : (uint32_t(1) << (Width % 32)) - 1;
+    #ifdef LIBENDIAN_HAS_SSE2
+        const __m128i* in = reinterpret_cast<const __m128i*>(src);
+        const __m128i vmask = _mm_set1_epi32(int(mask));
+        __m128i word = rows ? _mm_loadu_si128(in) : _mm_setzero_si128();
+        int shift = 0;
+        for(size_t r = 0; r < rows; ++r)
+        {
+            __m128i value = _mm_srl_epi32(word, _mm_cvtsi32_si128(shift));
+            shift += Width;
+            if(shift >= 32)
+            {
+                shift -= 32;
+                // Load the next word only if it exists: bits spill over, or more rows follow
+                if(shift || r + 1 < rows)
+                {
+                    word = _mm_loadu_si128(++in);
+                    if(shift)
+                        value = _mm_or_si128(value, _mm_sll_epi32(word, _mm_cvtsi32_si128(Width - shift)));
+                }
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 4 * r), _mm_and_si128(value, vmask));
+        }
+    #else
+        for(int lane = 0; lane < 4; ++lane)
+        {
+            const uint8_t* in = src + lane * UINT32_SIZE;
+            uint32_t word = 0;
+            if(rows)
+                memcpy(&word, in, UINT32_SIZE);
+            int shift = 0;
+            for(size_t r = 0; r < rows; ++r)
+            {
+                uint32_t value = shift < 32 ? word >> shift : 0;
+                shift += Width;
+                if(shift >= 32)
+                {
+                    shift -= 32;
+                    if(shift || r + 1 < rows)
+                    {
+                        in += 16;
+                        memcpy(&word, in, UINT32_SIZE);
+                        if(shift)
+                            value |= word << (Width - shift);
+                    }
+                }
+                dest[4 * r + lane] = value & mask;
+            }
+        }
+    #endif
+    }
+};
+
+/** One kernel per width, 0 has no data and is never called */
+#define LIBENDIAN_BIT_PACKING_KERNELS(KERNEL) \
+    nullptr, KERNEL<1>, KERNEL<2>, KERNEL<3>, KERNEL<4>, KERNEL<5>, KERNEL<6>, KERNEL<7>, KERNEL<8>, \
+    KERNEL<9>, KERNEL<10>, KERNEL<11>, KERNEL<12>, KERNEL<13>, KERNEL<14>, KERNEL<15>, KERNEL<16>, \
+    KERNEL<17>, KERNEL<18>, KERNEL<19>, KERNEL<20>, KERNEL<21>, KERNEL<22>, KERNEL<23>, KERNEL<24>, \
+    KERNEL<25>, KERNEL<26>, KERNEL<27>, KERNEL<28>, KERNEL<29>, KERNEL<30>, KERNEL<31>, KERNEL<32>
+
+template<class Endian>
+const typename BitPacking<Endian>::Packer BitPacking<Endian>::PACKERS[33] = { LIBENDIAN_BIT_PACKING_KERNELS(BitPacking<Endian>::template PACK) };
+
+template<class Endian>
+const typename BitPacking<Endian>::Unpacker BitPacking<Endian>::UNPACKERS[33] = { LIBENDIAN_BIT_PACKING_KERNELS(BitPacking<Endian>::template UNPACK) };
+
+#undef LIBENDIAN_BIT_PACKING_KERNELS
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
@@ -0,0 +1,314 @@
+/**
+ * \file BulkSwap.hpp
+ * \brief Byte swap and copy arrays, with optional non-temporal stores
+ */
+#ifndef __BULK_SWAP_HPP__
+#define __BULK_SWAP_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianHelpers.hpp>
+#include <EndianSimd.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Kernels behind MEMCPY_16/32/64.
+ *
+ * Arrays are processed with SSE2, SSSE3 or AVX2 when available. When streaming is selected
+ * (STORE_STREAMING, or STORE_AUTO and at least STREAMING_THRESHOLD bytes), the destination
+ * is written with non-temporal stores followed by a sfence, so a large conversion doesn't
+ * evict the working set from the caches.
+ * Overlapping buffers are supported but never streamed.
+ */
+class LIBENDIAN_API_ BulkSwap : public LibEndian
+{
+public:
+    /**
+     * \brief Byte swap count uint16_t from src to dest
+     * \param dest Destination buffer of count * 2 bytes
+     * \param src Source buffer of count * 2 bytes
+     * \param count Number of uint16_t
+     * \param mode Select cached or non-temporal stores
+     */
+    static void SWAP_16(uint8_t* dest, const uint8_t* src, const size_t count, const StoreMode mode = STORE_AUTO)
+    {
+        KERNEL<2>(dest, src, count * 2, mode);
+    }
+
+    /**
+     * \brief Byte swap count uint32_t from src to dest
+     * \param dest Destination buffer of count * 4 bytes
+     * \param src Source buffer of count * 4 bytes
+     * \param count Number of uint32_t
+     * \param mode Select cached or non-temporal stores
+     */
+    static void SWAP_32(uint8_t* dest, const uint8_t* src, const size_t count, const StoreMode mode = STORE_AUTO)
+    {
+        KERNEL<4>(dest, src, count * 4, mode);
+    }
+
+    /**
+     * \brief Byte swap count uint64_t from src to dest
+     * \param dest Destination buffer of count * 8 bytes
+     * \param src Source buffer of count * 8 bytes
+     * \param count Number of uint64_t
+     * \param mode Select cached or non-temporal stores
+     */
+    static void SWAP_64(uint8_t* dest, const uint8_t* src, const size_t count, const StoreMode mode = STORE_AUTO)
+    {
+        KERNEL<8>(dest, src, count * 8, mode);
+    }
+
+    /**
+     * \brief Copy size bytes from src to dest, like memmove when buffers overlap
+     * \param dest Destination buffer
+     * \param src Source buffer
+     * \param size Number of bytes
+     * \param mode Select cached or non-temporal stores
+     */
+    static void COPY(uint8_t* dest, const uint8_t* src, const size_t size, const StoreMode mode = STORE_AUTO)
+    {
+        KERNEL<1>(dest, src, size, mode);
+    }
+
+    /** True if a conversion of size bytes should use non-temporal stores */
+    static bool IS_STREAMING(const size_t size, const StoreMode mode)
+    {
+        return mode == STORE_STREAMING || (mode == STORE_AUTO && size >= STREAMING_THRESHOLD);
+    }
+
+    /**
+     * \brief Unpack count 48 bits integers packed every 6 bytes into 64 bits lanes
+     * \tparam BigOrder true if src is big endian, false if little endian
+     * \tparam Signed Sign extend bit 47 when true, zero extend otherwise
+     * \param dest Receive count values
+     * \param src Buffer of count * 6 bytes
+     * \param count Number of values
+     */
+    template<bool BigOrder, bool Signed>
+    static void UNPACK_48(uint64_t* dest, const uint8_t* src, const size_t count)
+    {
+        size_t i = 0;
+    #ifdef LIBENDIAN_HAS_SSSE3
+        // Each lane get its 6 bytes in little endian order, and the most significant byte copied in bytes 6 and 7
+        const __m128i shuffle = BigOrder ?
+            _mm_setr_epi8(5, 4, 3, 2, 1, 0, Signed ? 0 : -1, Signed ? 0 : -1, 11, 10, 9, 8, 7, 6, Signed ? 6 : -1, Signed ? 6 : -1) :
+            _mm_setr_epi8(0, 1, 2, 3, 4, 5, Signed ? 5 : -1, Signed ? 5 : -1, 6, 7, 8, 9, 10, 11, Signed ? 11 : -1, Signed ? 11 : -1);
+        const __m128i low48 = _mm_set1_epi64x(0x0000FFFFFFFFFFFFLL);
+        // 16 bytes are loaded for 2 values (12 bytes), stop while they are still inside src
+        for(; i + 3 <= count; i += 2)
+        {
+            __m128i x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 6)), shuffle);
+            if(Signed)
+            {
+                // Top 16 bits word hold the most significant byte twice, its sign fill the whole word
+                const __m128i sign = _mm_srai_epi16(x, 15);
+                x = _mm_or_si128(_mm_and_si128(x, low48), _mm_andnot_si128(low48, sign));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), x);
+        }
+    #endif
+        for(; i < count; ++i)
+        {
+            const uint8_t* buf = src + i * 6;
+            uint64_t value = 0;
+            for(int b = 0; b < 6; ++b)
+                value |= uint64_t(buf[BigOrder ? 5 - b : b]) << (8 * b);
+            if(Signed && (value & uint64_t(0x800000000000)))
+                value |= uint64_t(0xFFFF000000000000);
+            dest[i] = value;
+        }
+    }
+
+    /**
+     * \brief Pack the low 48 bits of count 64 bits integers every 6 bytes
+     * \tparam BigOrder true to write big endian, false for little endian
+     * \param dest Buffer of count * 6 bytes
+     * \param src Values to pack. Upper 16 bits are dropped, that also pack int64_t in range
+     * \param count Number of values
+     */
+    template<bool BigOrder>
+    static void PACK_48(uint8_t* dest, const uint64_t* src, const size_t count)
+    {
+        size_t i = 0;
+    #ifdef LIBENDIAN_HAS_SSSE3
+        const __m128i shuffle = BigOrder ?
+            _mm_setr_epi8(5, 4, 3, 2, 1, 0, 13, 12, 11, 10, 9, 8, -1, -1, -1, -1) :
+            _mm_setr_epi8(0, 1, 2, 3, 4, 5, 8, 9, 10, 11, 12, 13, -1, -1, -1, -1);
+        // 16 bytes are stored for 2 values (12 bytes), the 4 extra are overwritten by the next iteration.
+        // Stop while they are still inside dest
+        for(; i + 3 <= count; i += 2)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * 6), _mm_shuffle_epi8(x, shuffle));
+        }
+    #endif
+        for(; i < count; ++i)
+        {
+            uint8_t* buf = dest + i * 6;
+            for(int b = 0; b < 6; ++b)
+                buf[BigOrder ? 5 - b : b] = uint8_t(src[i] >> (8 * b));
+        }
+    }
+
+private:
+    template<int Width>
+    static void SWAP_ONE(uint8_t* dest, const uint8_t* src)
+    {
+        switch(Width)
+        {
+        case 2: { uint16_t v; memcpy(&v, src, 2); v = bswap_16(v); memcpy(dest, &v, 2); break; }
+        case 4: { uint32_t v; memcpy(&v, src, 4); v = bswap_32(v); memcpy(dest, &v, 4); break; }
+        case 8: { uint64_t v; memcpy(&v, src, 8); v = bswap_64(v); memcpy(dest, &v, 8); break; }
+        default: *dest = *src; break;
+        }
+    }
+
+    /** Scalar path, from begin to end (in bytes) */
+    template<int Width>
+    static void SCALAR(uint8_t* dest, const uint8_t* src, size_t begin, const size_t end)
+    {
+        if(Width == 1)
+        {
+            memmove(dest + begin, src + begin, end - begin);
+            return;
+        }
+        for(; begin + Width <= end; begin += Width)
+            SWAP_ONE<Width>(dest + begin, src + begin);
+    }
+
+#ifdef LIBENDIAN_HAS_SSE2
+    template<int Width>
+    static __m128i SWAP_128(__m128i x)
+    {
+    #ifdef LIBENDIAN_HAS_SSSE3
+        switch(Width)
+        {
+        case 2: return _mm_shuffle_epi8(x, _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+        case 4: return _mm_shuffle_epi8(x, _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+        case 8: return _mm_shuffle_epi8(x, _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8));
+        default: return x;
+        }
+    #else
+        if(Width == 1)
+            return x;
+        // Swap the bytes of each 16 bits word, then reverse the words inside each 32/64 bits lane
+        x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+        if(Width == 4)
+            return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+        if(Width == 8)
+            return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+        return x;
+    #endif
+    }
+#endif
+
+#ifdef LIBENDIAN_HAS_AVX2
+    template<int Width>
+    static __m256i SWAP_256(__m256i x)
+    {
+        switch(Width)
+        {
+        case 2: return _mm256_shuffle_epi8(x, _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                                               1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14));
+        case 4: return _mm256_shuffle_epi8(x, _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                                               3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12));
+        case 8: return _mm256_shuffle_epi8(x, _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                               7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8));
+        default: return x;
+        }
+    }
+#endif
+
+    template<int Width>
+    static void KERNEL(uint8_t* dest, const uint8_t* src, const size_t size, const StoreMode mode)
+    {
+        if(!size)
+            return;
+
+        if(dest != src && OVERLAP(uintptr_t(dest), uintptr_t(src), size))
+        {
+            if(Width == 1)
+                memmove(dest, src, size);
+            // Walk backward when dest is after src so no element is overwritten before being read
+            else if(dest > src)
+                for(size_t i = size / Width; i > 0; --i)
+                    SWAP_ONE<Width>(dest + (i - 1) * Width, src + (i - 1) * Width);
+            else
+                SCALAR<Width>(dest, src, 0, size);
+            return;
+        }
+
+        // Non-temporal stores need an aligned destination, reachable only if dest is aligned on Width
+        bool streaming = IS_STREAMING(size, mode) && uintptr_t(dest) % Width == 0;
+        if(Width == 1 && !streaming)
+        {
+            memcpy(dest, src, size);
+            return;
+        }
+
+        size_t i = 0;
+    #if defined(LIBENDIAN_HAS_AVX2)
+        const size_t vectorSize = 32;
+    #elif defined(LIBENDIAN_HAS_SSE2)
+        const size_t vectorSize = 16;
+    #endif
+
+    #ifdef LIBENDIAN_HAS_SSE2
+        if(streaming)
+        {
+            while(i + Width <= size && uintptr_t(dest + i) % vectorSize != 0)
+            {
+                SWAP_ONE<Width>(dest + i, src + i);
+                i += Width;
+            }
+        }
+      #ifdef LIBENDIAN_HAS_AVX2
+        for(; i + 32 <= size; i += 32)
+        {
+            const __m256i x = SWAP_256<Width>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+            if(streaming)
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + i), x);
+            else
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), x);
+        }
+      #else
+        for(; i + 16 <= size; i += 16)
+        {
+            const __m128i x = SWAP_128<Width>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+            if(streaming)
+                _mm_stream_si128(reinterpret_cast<__m128i*>(dest + i), x);
+            else
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), x);
+        }
+      #endif
+        if(streaming)
+            _mm_sfence();
+    #else
+        (void)streaming;
+    #endif
+        SCALAR<Width>(dest, src, i, size);
+    }
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
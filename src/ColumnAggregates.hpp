@@ -0,0 +1,273 @@
+/**
+ * \file ColumnAggregates.hpp
+ * \brief Sum, min, max, range count and histogram computed directly over serialized columns
+ */
+#ifndef __COLUMN_AGGREGATES_HPP__
+#define __COLUMN_AGGREGATES_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianSimd.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Reduce count T serialized with Endian (BigEndian or LittleEndian) without decoding the column first.
+ *
+ * T is uint16_t, uint32_t, uint64_t, int16_t, int32_t, int64_t, float or double. The column is read once,
+ * BLOCK_SIZE values at a time: each block is byte swapped by Endian::MEMCPY_xx into a buffer that stays in
+ * L1, then reduced by a loop the compiler vectorizes. No temporary of the size of the column is needed.
+ * When Endian is the host order the values are reduced in place.
+ *
+ * NaN are ignored by MIN_MAX, COUNT_IN_RANGE and HISTOGRAM, and propagated by SUM.
+ */
+template<class Endian>
+class ColumnAggregates : public LibEndian
+{
+public:
+    /** Number of values decoded at a time */
+    static const size_t BLOCK_SIZE = 256;
+
+    /** Type of a sum of T: uint64_t, int64_t or double. Integer sums wrap around on overflow */
+    template<typename T>
+    struct Sum
+    {
+        typedef typename std::conditional<std::is_floating_point<T>::value, double,
+            typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type>::type Type;
+    };
+
+    /**
+     * \brief Sum of count values
+     * \param src Serialized column
+     * \param count Number of values
+     */
+    template<typename T>
+    static typename Sum<T>::Type SUM(const uint8_t* src, const size_t count)
+    {
+        typedef typename Sum<T>::Type S;
+        // Signed integers are added as unsigned, that wrap around without undefined behavior
+        typedef typename std::conditional<std::is_integral<S>::value, uint64_t, S>::type Accumulator;
+        // The compiler doesn't reorder floating point additions: independent accumulators, so they don't wait for each other
+        Accumulator acc[SUM_LANES] = {};
+        FOR_EACH_BLOCK<T>(src, count, [&](const T* values, const size_t n)
+        {
+            size_t i = 0;
+            if(std::is_floating_point<T>::value)
+            {
+                for(; i + SUM_LANES <= n; i += SUM_LANES)
+                {
+                    for(size_t lane = 0; lane < SUM_LANES; ++lane)
+                        acc[lane] += Accumulator(values[i + lane]);
+                }
+            }
+            Accumulator sum = 0;
+            for(; i < n; ++i)
+                sum += Accumulator(S(values[i]));
+            acc[0] += sum;
+        });
+        Accumulator total = 0;
+        for(size_t lane = 0; lane < SUM_LANES; ++lane)
+            total += acc[lane];
+        return S(total);
+    }
+
+    /**
+     * \brief Smallest and biggest of count values
+     * \param min Receive the smallest value, +infinity for float and double or std::numeric_limits<T>::max() if there is none
+     * \param max Receive the biggest value, -infinity for float and double or std::numeric_limits<T>::lowest() if there is none
+     * \return false if the column is empty (or only hold NaN)
+     */
+    template<typename T>
+    static bool MIN_MAX(const uint8_t* src, const size_t count, T& min, T& max)
+    {
+        // Bounds at max() and lowest() would report them for a column of only +infinity or -infinity
+        T lo = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::max();
+        T hi = std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+        FOR_EACH_BLOCK<T>(src, count, [&](const T* values, const size_t n)
+        {
+            MIN_MAX_BLOCK(values, n, lo, hi);
+        });
+        min = lo;
+        max = hi;
+        // Any value v leave lo <= v <= hi, NaN leave the bounds crossed
+        return lo <= hi;
+    }
+
+    /** Smallest of count values, +infinity or std::numeric_limits<T>::max() if there is none */
+    template<typename T>
+    static T MIN(const uint8_t* src, const size_t count)
+    {
+        T min, max;
+        MIN_MAX<T>(src, count, min, max);
+        return min;
+    }
+
+    /** Biggest of count values, -infinity or std::numeric_limits<T>::lowest() if there is none */
+    template<typename T>
+    static T MAX(const uint8_t* src, const size_t count)
+    {
+        T min, max;
+        MIN_MAX<T>(src, count, min, max);
+        return max;
+    }
+
+    /** Number of values in [low, high] */
+    template<typename T>
+    static size_t COUNT_IN_RANGE(const uint8_t* src, const size_t count, const T low, const T high)
+    {
+        size_t result = 0;
+        FOR_EACH_BLOCK<T>(src, count, [&](const T* values, const size_t n)
+        {
+            for(size_t i = 0; i < n; ++i)
+                result += (values[i] >= low) & (values[i] <= high);
+        });
+        return result;
+    }
+
+    /**
+     * \brief Add the values in [low, high) to buckets equal width buckets
+     * \param histogram Array of buckets counters, incremented and not cleared
+     * \return Number of values counted, the others are out of range
+     */
+    template<typename T>
+    static size_t HISTOGRAM(const uint8_t* src, const size_t count, const T low, const T high,
+        const size_t buckets, size_t* histogram)
+    {
+        if(!buckets || !(low < high))
+            return 0;
+        size_t counted = 0;
+        const double scale = double(buckets) / (double(high) - double(low));
+        FOR_EACH_BLOCK<T>(src, count, [&](const T* values, const size_t n)
+        {
+            for(size_t i = 0; i < n; ++i)
+            {
+                const T value = values[i];
+                if(!(value >= low && value < high))
+                    continue;
+                size_t bucket = size_t((double(value) - double(low)) * scale);
+                // Rounding of wide integers can land on the upper bound
+                if(bucket >= buckets)
+                    bucket = buckets - 1;
+                ++histogram[bucket];
+                ++counted;
+            }
+        });
+        return counted;
+    }
+
+private:
+    /** Accumulators of a floating point sum, two AVX registers of double */
+    static const size_t SUM_LANES = 8;
+
+    /** Widen [lo, hi] to n native values */
+    template<typename T>
+    static void MIN_MAX_BLOCK(const T* values, const size_t n, T& lo, T& hi)
+    {
+        for(size_t i = 0; i < n; ++i)
+        {
+            lo = values[i] < lo ? values[i] : lo;
+            hi = values[i] > hi ? values[i] : hi;
+        }
+    }
+
+#ifdef LIBENDIAN_HAS_SSE2
+    // The compilers don't vectorize floating point min/max, because of NaN. minps and maxps return their
+    // second operand when one is NaN: with the bounds there, NaN are skipped like in the scalar loop
+
+    static void MIN_MAX_BLOCK(const float* values, const size_t n, float& lo, float& hi)
+    {
+        __m128 low = _mm_set1_ps(lo);
+        __m128 high = _mm_set1_ps(hi);
+        size_t i = 0;
+        for(; i + 4 <= n; i += 4)
+        {
+            const __m128 x = _mm_loadu_ps(values + i);
+            low = _mm_min_ps(x, low);
+            high = _mm_max_ps(x, high);
+        }
+        alignas(16) float lows[4];
+        alignas(16) float highs[4];
+        _mm_store_ps(lows, low);
+        _mm_store_ps(highs, high);
+        for(int lane = 0; lane < 4; ++lane)
+        {
+            lo = lows[lane] < lo ? lows[lane] : lo;
+            hi = highs[lane] > hi ? highs[lane] : hi;
+        }
+        MIN_MAX_BLOCK<float>(values + i, n - i, lo, hi);
+    }
+
+    static void MIN_MAX_BLOCK(const double* values, const size_t n, double& lo, double& hi)
+    {
+        __m128d low = _mm_set1_pd(lo);
+        __m128d high = _mm_set1_pd(hi);
+        size_t i = 0;
+        for(; i + 2 <= n; i += 2)
+        {
+            const __m128d x = _mm_loadu_pd(values + i);
+            low = _mm_min_pd(x, low);
+            high = _mm_max_pd(x, high);
+        }
+        alignas(16) double lows[2];
+        alignas(16) double highs[2];
+        _mm_store_pd(lows, low);
+        _mm_store_pd(highs, high);
+        for(int lane = 0; lane < 2; ++lane)
+        {
+            lo = lows[lane] < lo ? lows[lane] : lo;
+            hi = highs[lane] > hi ? highs[lane] : hi;
+        }
+        MIN_MAX_BLOCK<double>(values + i, n - i, lo, hi);
+    }
+#endif
+
+    /** Call reduce(values, n) on native blocks of at most BLOCK_SIZE values */
+    template<typename T, typename Reduce>
+    static void FOR_EACH_BLOCK(const uint8_t* src, const size_t count, const Reduce& reduce)
+    {
+        static_assert(std::is_arithmetic<T>::value && sizeof(T) >= 2 && sizeof(T) <= 8 && sizeof(T) != 6,
+            "T must be a 16, 32 or 64 bits integer, float or double");
+        T block[BLOCK_SIZE];
+        const bool aligned = uintptr_t(src) % alignof(T) == 0;
+        for(size_t begin = 0; begin < count; begin += BLOCK_SIZE)
+        {
+            const size_t n = count - begin < BLOCK_SIZE ? count - begin : BLOCK_SIZE;
+            const uint8_t* in = src + begin * sizeof(T);
+            if(Endian::IS_HOST_ORDER && aligned)
+            {
+                reduce(reinterpret_cast<const T*>(in), n);
+                continue;
+            }
+            uint8_t* out = reinterpret_cast<uint8_t*>(block);
+            switch(sizeof(T))
+            {
+            case 2: Endian::MEMCPY_16(out, in, n, STORE_CACHED); break;
+            case 4: Endian::MEMCPY_32(out, in, n, STORE_CACHED); break;
+            default: Endian::MEMCPY_64(out, in, n, STORE_CACHED); break;
+            }
+            reduce(block, n);
+        }
+    }
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
@@ -0,0 +1,269 @@
+/**
+ * \file ConstexprEndian.hpp
+ * \brief Serialize into std::array at compile time
+ * \note Require C++17. Floating point functions require C++20 std::bit_cast.
+ */
+#ifndef __CONSTEXPR_ENDIAN_HPP__
+#define __CONSTEXPR_ENDIAN_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+
+#if (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L) || __cplusplus >= 201703L
+/** Set when ConstexprEndian is available */
+#define LIBENDIAN_HAS_CONSTEXPR_ENDIAN
+#include <array>
+#include <type_traits>
+#if defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+#endif
+
+#ifdef LIBENDIAN_HAS_CONSTEXPR_ENDIAN
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Constexpr counterpart of BigEndian/LittleEndian working on std::array<uint8_t, N>.
+ *
+ * Unlike the GET_xx/SET_xx functions of BigEndian and LittleEndian, these functions never
+ * reinterpret pointers and can be evaluated by the compiler. Constant frames, magic numbers
+ * and lookup tables built with them end up in read only data instead of being serialized at runtime.
+ *
+ * \code
+ * static constexpr auto HEADER = ConstexprBigEndian::Writer<8>().UINT32(0xCAFEBABE).UINT16(1).UINT16(0).data();
+ * \endcode
+ */
+template<bool BigOrder>
+class ConstexprEndian
+{
+public:
+    /** Size of the 48 bits types (6 bytes) */
+    static constexpr size_t UINT48_SIZE = 6;
+
+    /**
+     * \brief Deserialize an unsigned integer of width bytes
+     * \param buf Buffer to read from
+     * \param offset Offset in the buffer (in bytes)
+     * \param width Number of bytes, between 1 and 8
+     */
+    template<size_t N>
+    static constexpr uint64_t GET_BYTES(const std::array<uint8_t, N>& buf, const size_t offset, const size_t width)
+    {
+        uint64_t val = 0;
+        for(size_t i = 0; i < width; ++i)
+        {
+            const uint64_t byte = buf[offset + i];
+            val |= BigOrder ? byte << ((width - 1 - i) * 8) : byte << (i * 8);
+        }
+        return val;
+    }
+
+    /**
+     * \brief Serialize the width lower bytes of val
+     * \param buf Buffer to write in
+     * \param offset Offset in the buffer (in bytes)
+     * \param width Number of bytes, between 1 and 8
+     * \param val Value to serialize
+     */
+    template<size_t N>
+    static constexpr void SET_BYTES(std::array<uint8_t, N>& buf, const size_t offset, const size_t width, const uint64_t val)
+    {
+        for(size_t i = 0; i < width; ++i)
+        {
+            const size_t shift = BigOrder ? (width - 1 - i) * 8 : i * 8;
+            buf[offset + i] = uint8_t((val >> shift) & 0xFF);
+        }
+    }
+
+    /** Deserialize an uint8_t at offset */
+    template<size_t N> static constexpr uint8_t GET_UINT8(const std::array<uint8_t, N>& buf, const size_t offset) { return uint8_t(GET_BYTES(buf, offset, 1)); }
+    /** Deserialize an uint16_t at offset */
+    template<size_t N> static constexpr uint16_t GET_UINT16(const std::array<uint8_t, N>& buf, const size_t offset) { return uint16_t(GET_BYTES(buf, offset, 2)); }
+    /** Deserialize an uint32_t at offset */
+    template<size_t N> static constexpr uint32_t GET_UINT32(const std::array<uint8_t, N>& buf, const size_t offset) { return uint32_t(GET_BYTES(buf, offset, 4)); }
+    /** Deserialize an uint48_t at offset, returned in an uint64_t */
+    template<size_t N> static constexpr uint64_t GET_UINT48(const std::array<uint8_t, N>& buf, const size_t offset) { return GET_BYTES(buf, offset, 6); }
+    /** Deserialize an uint64_t at offset */
+    template<size_t N> static constexpr uint64_t GET_UINT64(const std::array<uint8_t, N>& buf, const size_t offset) { return GET_BYTES(buf, offset, 8); }
+
+    /** Deserialize an int8_t at offset */
+    template<size_t N> static constexpr int8_t GET_INT8(const std::array<uint8_t, N>& buf, const size_t offset) { return int8_t(GET_UINT8(buf, offset)); }
+    /** Deserialize an int16_t at offset */
+    template<size_t N> static constexpr int16_t GET_INT16(const std::array<uint8_t, N>& buf, const size_t offset) { return int16_t(GET_UINT16(buf, offset)); }
+    /** Deserialize an int32_t at offset */
+    template<size_t N> static constexpr int32_t GET_INT32(const std::array<uint8_t, N>& buf, const size_t offset) { return int32_t(GET_UINT32(buf, offset)); }
+    /** Deserialize an int48_t at offset, sign extended in an int64_t */
+    template<size_t N> static constexpr int64_t GET_INT48(const std::array<uint8_t, N>& buf, const size_t offset)
+    {
+        const uint64_t val = GET_UINT48(buf, offset);
+        return int64_t(val & 0x800000000000ull ? val | 0xFFFF000000000000ull : val);
+    }
+    /** Deserialize an int64_t at offset */
+    template<size_t N> static constexpr int64_t GET_INT64(const std::array<uint8_t, N>& buf, const size_t offset) { return int64_t(GET_UINT64(buf, offset)); }
+
+    /** Serialize an uint8_t at offset */
+    template<size_t N> static constexpr void SET_UINT8(std::array<uint8_t, N>& buf, const size_t offset, const uint8_t val) { SET_BYTES(buf, offset, 1, val); }
+    /** Serialize an uint16_t at offset */
+    template<size_t N> static constexpr void SET_UINT16(std::array<uint8_t, N>& buf, const size_t offset, const uint16_t val) { SET_BYTES(buf, offset, 2, val); }
+    /** Serialize an uint32_t at offset */
+    template<size_t N> static constexpr void SET_UINT32(std::array<uint8_t, N>& buf, const size_t offset, const uint32_t val) { SET_BYTES(buf, offset, 4, val); }
+    /** Serialize an uint48_t stored in an uint64_t at offset */
+    template<size_t N> static constexpr void SET_UINT48(std::array<uint8_t, N>& buf, const size_t offset, const uint64_t val) { SET_BYTES(buf, offset, 6, val); }
+    /** Serialize an uint64_t at offset */
+    template<size_t N> static constexpr void SET_UINT64(std::array<uint8_t, N>& buf, const size_t offset, const uint64_t val) { SET_BYTES(buf, offset, 8, val); }
+
+    /** Serialize an int8_t at offset */
+    template<size_t N> static constexpr void SET_INT8(std::array<uint8_t, N>& buf, const size_t offset, const int8_t val) { SET_BYTES(buf, offset, 1, uint8_t(val)); }
+    /** Serialize an int16_t at offset */
+    template<size_t N> static constexpr void SET_INT16(std::array<uint8_t, N>& buf, const size_t offset, const int16_t val) { SET_BYTES(buf, offset, 2, uint16_t(val)); }
+    /** Serialize an int32_t at offset */
+    template<size_t N> static constexpr void SET_INT32(std::array<uint8_t, N>& buf, const size_t offset, const int32_t val) { SET_BYTES(buf, offset, 4, uint32_t(val)); }
+    /** Serialize an int48_t stored in an int64_t at offset */
+    template<size_t N> static constexpr void SET_INT48(std::array<uint8_t, N>& buf, const size_t offset, const int64_t val) { SET_BYTES(buf, offset, 6, uint64_t(val)); }
+    /** Serialize an int64_t at offset */
+    template<size_t N> static constexpr void SET_INT64(std::array<uint8_t, N>& buf, const size_t offset, const int64_t val) { SET_BYTES(buf, offset, 8, uint64_t(val)); }
+
+#ifdef __cpp_lib_bit_cast
+    /** Deserialize a float at offset */
+    template<size_t N> static constexpr float GET_FLOAT32(const std::array<uint8_t, N>& buf, const size_t offset) { return std::bit_cast<float>(GET_UINT32(buf, offset)); }
+    /** Deserialize a double at offset */
+    template<size_t N> static constexpr double GET_FLOAT64(const std::array<uint8_t, N>& buf, const size_t offset) { return std::bit_cast<double>(GET_UINT64(buf, offset)); }
+    /** Serialize a float at offset */
+    template<size_t N> static constexpr void SET_FLOAT32(std::array<uint8_t, N>& buf, const size_t offset, const float val) { SET_UINT32(buf, offset, std::bit_cast<uint32_t>(val)); }
+    /** Serialize a double at offset */
+    template<size_t N> static constexpr void SET_FLOAT64(std::array<uint8_t, N>& buf, const size_t offset, const double val) { SET_UINT64(buf, offset, std::bit_cast<uint64_t>(val)); }
+#endif
+
+    /**
+     * \brief Serialize any integral (or floating point with C++20) T at offset
+     * \return Number of bytes written
+     */
+    template<typename T, size_t N>
+    static constexpr size_t SET(std::array<uint8_t, N>& buf, const size_t offset, const T val)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be serialized");
+#ifdef __cpp_lib_bit_cast
+        if constexpr(std::is_floating_point<T>::value)
+        {
+            using Bits = typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type;
+            SET_BYTES(buf, offset, sizeof(T), std::bit_cast<Bits>(val));
+        }
+        else
+#endif
+        {
+            static_assert(std::is_integral<T>::value, "Floating point serialization require std::bit_cast");
+            SET_BYTES(buf, offset, sizeof(T), uint64_t(typename std::make_unsigned<T>::type(val)));
+        }
+        return sizeof(T);
+    }
+
+    /**
+     * \brief Build a serialized lookup table of Count values of type T, generated by f(index)
+     * \code
+     * static constexpr auto SQUARES = ConstexprBigEndian::TABLE<uint32_t, 256>([](size_t i) { return uint32_t(i * i); });
+     * \endcode
+     */
+    template<typename T, size_t Count, typename F>
+    static constexpr std::array<uint8_t, Count * sizeof(T)> TABLE(F f)
+    {
+        std::array<uint8_t, Count * sizeof(T)> buf{};
+        for(size_t i = 0; i < Count; ++i)
+            SET<T>(buf, i * sizeof(T), T(f(i)));
+        return buf;
+    }
+
+    /**
+     * \brief Serialize fields one after the other in a std::array<uint8_t, N>, at compile time.
+     * Writing past N is a compile error when evaluated in a constant expression.
+     */
+    template<size_t N>
+    class Writer
+    {
+    public:
+        constexpr Writer() : _buf{}, _offset(0) {}
+
+        /** Append an uint8_t */
+        constexpr Writer& UINT8(const uint8_t val) { return append(val); }
+        /** Append an uint16_t */
+        constexpr Writer& UINT16(const uint16_t val) { return append(val); }
+        /** Append an uint32_t */
+        constexpr Writer& UINT32(const uint32_t val) { return append(val); }
+        /** Append an uint48_t stored in an uint64_t */
+        constexpr Writer& UINT48(const uint64_t val) { SET_UINT48(_buf, _offset, val); _offset += UINT48_SIZE; return *this; }
+        /** Append an uint64_t */
+        constexpr Writer& UINT64(const uint64_t val) { return append(val); }
+        /** Append an int8_t */
+        constexpr Writer& INT8(const int8_t val) { return append(val); }
+        /** Append an int16_t */
+        constexpr Writer& INT16(const int16_t val) { return append(val); }
+        /** Append an int32_t */
+        constexpr Writer& INT32(const int32_t val) { return append(val); }
+        /** Append an int48_t stored in an int64_t */
+        constexpr Writer& INT48(const int64_t val) { SET_INT48(_buf, _offset, val); _offset += UINT48_SIZE; return *this; }
+        /** Append an int64_t */
+        constexpr Writer& INT64(const int64_t val) { return append(val); }
+#ifdef __cpp_lib_bit_cast
+        /** Append a float */
+        constexpr Writer& FLOAT32(const float val) { return append(val); }
+        /** Append a double */
+        constexpr Writer& FLOAT64(const double val) { return append(val); }
+#endif
+        /** Append raw bytes */
+        template<size_t M>
+        constexpr Writer& BYTES(const std::array<uint8_t, M>& bytes)
+        {
+            for(size_t i = 0; i < M; ++i)
+                _buf[_offset + i] = bytes[i];
+            _offset += M;
+            return *this;
+        }
+        /** Skip count bytes, left to 0 */
+        constexpr Writer& PADDING(const size_t count) { _offset += count; return *this; }
+
+        /** Number of bytes written */
+        constexpr size_t size() const { return _offset; }
+        /** The serialized buffer */
+        constexpr std::array<uint8_t, N> data() const { return _buf; }
+
+    private:
+        template<typename T>
+        constexpr Writer& append(const T val)
+        {
+            _offset += SET<T>(_buf, _offset, val);
+            return *this;
+        }
+
+        std::array<uint8_t, N> _buf;
+        size_t _offset;
+    };
+};
+
+/** Compile time big endian serialization */
+typedef ConstexprEndian<true> ConstexprBigEndian;
+/** Compile time little endian serialization */
+typedef ConstexprEndian<false> ConstexprLittleEndian;
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
+
+#endif
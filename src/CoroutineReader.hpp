@@ -0,0 +1,277 @@
+/**
+ * \file CoroutineReader.hpp
+ * \brief Incremental parser for fragmented input based on C++20 coroutines
+ * \note Only available when the compiler support C++20 coroutines.
+ */
+#ifndef __COROUTINE_READER_HPP__
+#define __COROUTINE_READER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianTraits.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+/** Set when CoroutineReader is available */
+#define LIBENDIAN_HAS_COROUTINE_READER
+#endif
+#endif
+
+#ifdef LIBENDIAN_HAS_COROUTINE_READER
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Feed arbitrary sized chunks to a parser coroutine.
+ *
+ * The parser `co_await reader.get<uint32_t>()` and is suspended when the bytes run out.
+ * It is resumed by the next feed() call. Values are read in place with the Endian
+ * (BigEndian or LittleEndian) functions, only a value that straddle two chunks
+ * is stitched in an 8 bytes buffer.
+ *
+ * \code
+ * CoroutineReader<BigEndian>::Task parse(CoroutineReader<BigEndian>& reader)
+ * {
+ *     for(;;)
+ *     {
+ *         const uint32_t length = co_await reader.get<uint32_t>();
+ *         co_await reader.read(payload, length);
+ *     }
+ * }
+ * \endcode
+ */
+template<class Endian>
+class CoroutineReader
+{
+public:
+    /** \brief Coroutine type returned by parsers. The coroutine start immediately and is destroyed with the Task */
+    class Task
+    {
+    public:
+        struct promise_type
+        {
+            Task get_return_object() { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        Task(Task&& other) noexcept : _handle(other._handle) { other._handle = nullptr; }
+        Task& operator=(Task&& other) noexcept
+        {
+            if(this != &other)
+            {
+                if(_handle)
+                    _handle.destroy();
+                _handle = other._handle;
+                other._handle = nullptr;
+            }
+            return *this;
+        }
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task()
+        {
+            if(_handle)
+                _handle.destroy();
+        }
+
+        /** True once the parser returned */
+        bool done() const { return !_handle || _handle.done(); }
+
+    private:
+        explicit Task(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+        std::coroutine_handle<promise_type> _handle;
+    };
+
+    /** \brief Awaitable returned by get<T>() */
+    template<typename T>
+    class ValueAwaiter
+    {
+    public:
+        explicit ValueAwaiter(CoroutineReader& reader) : _reader(reader) {}
+
+        bool await_ready()
+        {
+            const uint8_t* buf;
+            if(!_reader.take(EndianTraits<Endian, T>::SIZE, buf))
+                return false;
+            _value = EndianTraits<Endian, T>::GET(buf);
+            return true;
+        }
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            _reader._pending = EndianTraits<Endian, T>::SIZE;
+            _reader._waiting = handle;
+        }
+        T await_resume()
+        {
+            // Resumed by feed, that completed the value
+            if(_reader._ready)
+            {
+                _value = EndianTraits<Endian, T>::GET(_reader._ready);
+                _reader._ready = nullptr;
+            }
+            return _value;
+        }
+
+    private:
+        CoroutineReader& _reader;
+        T _value = T();
+    };
+
+    /** \brief Awaitable returned by read() */
+    class BytesAwaiter
+    {
+    public:
+        BytesAwaiter(CoroutineReader& reader, uint8_t* dest, const size_t count) : _reader(reader)
+        {
+            _reader._readDest = dest;
+            _reader._readRemaining = count;
+        }
+
+        bool await_ready() { return _reader.copy(); }
+        void await_suspend(std::coroutine_handle<> handle) { _reader._waiting = handle; }
+        void await_resume() {}
+
+    private:
+        CoroutineReader& _reader;
+    };
+
+    CoroutineReader() = default;
+    CoroutineReader(const CoroutineReader&) = delete;
+    CoroutineReader& operator=(const CoroutineReader&) = delete;
+
+    /** Awaitable that return the next T in the stream */
+    template<typename T>
+    ValueAwaiter<T> get() { return ValueAwaiter<T>(*this); }
+
+    /**
+     * \brief Awaitable that copy the next count bytes into dest, that can be nullptr to skip them.
+     * Copy directly from the chunks, without intermediate buffer.
+     */
+    BytesAwaiter read(uint8_t* dest, const size_t count) { return BytesAwaiter(*this, dest, count); }
+
+    /**
+     * \brief Give the next chunk to the parser, and resume it if it was waiting for bytes.
+     * The chunk must stay valid until the call return, it isn't referenced afterward.
+     * \param data Pointer to the chunk
+     * \param size Size of the chunk (in bytes)
+     * \return Number of bytes consumed. Smaller than size only if the parser returned.
+     */
+    size_t feed(const uint8_t* data, const size_t size)
+    {
+        _data = data;
+        _size = size;
+        _pos = 0;
+        if(_waiting)
+        {
+            if(_pending)
+            {
+                const uint8_t* buf;
+                if(!take(_pending, buf))
+                    return finishChunk();
+                _pending = 0;
+                _ready = buf;
+            }
+            else if(!copy())
+                return finishChunk();
+
+            std::coroutine_handle<> handle = _waiting;
+            _waiting = nullptr;
+            handle.resume();
+        }
+        return finishChunk();
+    }
+
+    /** Number of bytes of the current value already stitched from previous chunks */
+    size_t stitched() const { return _stitched; }
+
+private:
+    size_t finishChunk()
+    {
+        const size_t consumed = _pos;
+        _data = nullptr;
+        _size = 0;
+        _pos = 0;
+        return consumed;
+    }
+
+    /** Return a pointer to count contiguous bytes, or stitch what is available and return false */
+    bool take(const size_t count, const uint8_t*& buf)
+    {
+        if(!_stitched && _size - _pos >= count)
+        {
+            buf = _data + _pos;
+            _pos += count;
+            return true;
+        }
+        const size_t missing = count - _stitched;
+        const size_t available = _size - _pos;
+        const size_t chunk = missing < available ? missing : available;
+        if(chunk)
+            memcpy(_stitch + _stitched, _data + _pos, chunk);
+        _stitched += chunk;
+        _pos += chunk;
+        if(_stitched < count)
+            return false;
+        _stitched = 0;
+        buf = _stitch;
+        return true;
+    }
+
+    /** Copy as much as possible of the pending read(), return true when complete */
+    bool copy()
+    {
+        const size_t available = _size - _pos;
+        const size_t chunk = _readRemaining < available ? _readRemaining : available;
+        if(_readDest && chunk)
+        {
+            memcpy(_readDest, _data + _pos, chunk);
+            _readDest += chunk;
+        }
+        _pos += chunk;
+        _readRemaining -= chunk;
+        return _readRemaining == 0;
+    }
+
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+    size_t _pos = 0;
+
+    uint8_t _stitch[8] = {};
+    size_t _stitched = 0;
+    size_t _pending = 0;
+    const uint8_t* _ready = nullptr;
+
+    uint8_t* _readDest = nullptr;
+    size_t _readRemaining = 0;
+
+    std::coroutine_handle<> _waiting = nullptr;
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
+
+#endif
@@ -0,0 +1,302 @@
+/**
+ * \file DeltaCoding.hpp
+ * \brief Delta and frame of reference encoding of integer columns
+ */
+#ifndef __DELTA_CODING_HPP__
+#define __DELTA_CODING_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianSimd.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Encode uint64_t columns as a base value followed by fixed width offsets.
+ *
+ * Both formats start with a UINT64 base and a UINT8 width (0, 1, 2, 4 or 8 bytes),
+ * followed by the offsets serialized with Endian (BigEndian or LittleEndian).
+ * - Delta : base is the first value, offsets are the differences between consecutive values.
+ * - Frame of reference : base is the minimum, offsets are the differences with the minimum.
+ *
+ * The number of values is not stored, it must be known by the caller.
+ * Delta coding is lossless for any input, but only shrink monotonic columns.
+ * Decoders reject any other width by returning 0.
+ */
+template<class Endian>
+class DeltaCoding : public LibEndian
+{
+public:
+    /** Size of the header before the offsets (base + width) */
+    static const uint8_t HEADER_SIZE = UINT64_SIZE + UINT8_SIZE;
+
+    /**
+     * \brief Smallest width (0, 1, 2, 4 or 8 bytes) that can hold maxValue
+     * \param maxValue Biggest offset to store
+     */
+    static uint8_t WIDTH_FOR(const uint64_t maxValue)
+    {
+        if(maxValue == 0)
+            return 0;
+        if(maxValue <= 0xFF)
+            return 1;
+        if(maxValue <= 0xFFFF)
+            return 2;
+        if(maxValue <= 0xFFFFFFFF)
+            return 4;
+        return 8;
+    }
+
+    /**
+     * \brief Number of bytes written by ENCODE_DELTA_64 for src
+     * \param src Values to encode
+     * \param count Number of values in src
+     */
+    static size_t DELTA_ENCODED_SIZE(const uint64_t* src, const size_t count)
+    {
+        if(!count)
+            return 0;
+        return HEADER_SIZE + (count - 1) * WIDTH_FOR(MAX_DELTA(src, count));
+    }
+
+    /**
+     * \brief Delta encode count uint64_t
+     * \param dest Buffer of at least DELTA_ENCODED_SIZE bytes
+     * \param src Values to encode
+     * \param count Number of values in src
+     * \return Number of bytes written in dest
+     */
+    static size_t ENCODE_DELTA_64(uint8_t* dest, const uint64_t* src, const size_t count)
+    {
+        if(!count)
+            return 0;
+        const uint8_t width = WIDTH_FOR(MAX_DELTA(src, count));
+        Endian::SET_UINT64(dest, src[0]);
+        Endian::SET_UINT8(dest, UINT64_SIZE, width);
+        uint8_t* out = dest + HEADER_SIZE;
+        for(size_t i = 1; i < count; ++i, out += width)
+            WRITE_OFFSET(out, width, src[i] - src[i - 1]);
+        return out - dest;
+    }
+
+    /**
+     * \brief Decode count uint64_t encoded with ENCODE_DELTA_64
+     * \param dest Buffer of at least count uint64_t
+     * \param src Encoded buffer
+     * \param count Number of values to decode
+     * \return Number of bytes read from src, 0 if count is 0 or the width isn't 0, 1, 2, 4 or 8
+     */
+    static size_t DECODE_DELTA_64(uint64_t* dest, const uint8_t* src, const size_t count)
+    {
+        if(!count)
+            return 0;
+        const uint64_t first = Endian::GET_UINT64(src);
+        const uint8_t width = Endian::GET_UINT8(src, UINT64_SIZE);
+        if(!IS_VALID_WIDTH(width))
+            return 0;
+        dest[0] = first;
+        // Offsets are widened and summed one block at a time, while the block is still in L1
+        for(size_t begin = 1; begin < count; begin += BLOCK_SIZE)
+        {
+            const size_t n = count - begin < BLOCK_SIZE ? count - begin : BLOCK_SIZE;
+            READ_OFFSETS(dest + begin, src + HEADER_SIZE + (begin - 1) * width, width, n);
+            PREFIX_SUM_64(dest + begin, n, dest[begin - 1]);
+        }
+        return HEADER_SIZE + (count - 1) * width;
+    }
+
+    /**
+     * \brief Number of bytes written by ENCODE_FOR_64 for src
+     * \param src Values to encode
+     * \param count Number of values in src
+     */
+    static size_t FOR_ENCODED_SIZE(const uint64_t* src, const size_t count)
+    {
+        if(!count)
+            return 0;
+        uint64_t min, max;
+        MIN_MAX(src, count, min, max);
+        return HEADER_SIZE + count * WIDTH_FOR(max - min);
+    }
+
+    /**
+     * \brief Frame of reference encode count uint64_t
+     * \param dest Buffer of at least FOR_ENCODED_SIZE bytes
+     * \param src Values to encode
+     * \param count Number of values in src
+     * \return Number of bytes written in dest
+     */
+    static size_t ENCODE_FOR_64(uint8_t* dest, const uint64_t* src, const size_t count)
+    {
+        if(!count)
+            return 0;
+        uint64_t min, max;
+        MIN_MAX(src, count, min, max);
+        const uint8_t width = WIDTH_FOR(max - min);
+        Endian::SET_UINT64(dest, min);
+        Endian::SET_UINT8(dest, UINT64_SIZE, width);
+        uint8_t* out = dest + HEADER_SIZE;
+        for(size_t i = 0; i < count; ++i, out += width)
+            WRITE_OFFSET(out, width, src[i] - min);
+        return out - dest;
+    }
+
+    /**
+     * \brief Decode count uint64_t encoded with ENCODE_FOR_64
+     * \param dest Buffer of at least count uint64_t
+     * \param src Encoded buffer
+     * \param count Number of values to decode
+     * \return Number of bytes read from src, 0 if count is 0 or the width isn't 0, 1, 2, 4 or 8
+     */
+    static size_t DECODE_FOR_64(uint64_t* dest, const uint8_t* src, const size_t count)
+    {
+        if(!count)
+            return 0;
+        const uint64_t reference = Endian::GET_UINT64(src);
+        const uint8_t width = Endian::GET_UINT8(src, UINT64_SIZE);
+        if(!IS_VALID_WIDTH(width))
+            return 0;
+        READ_OFFSETS(dest, src + HEADER_SIZE, width, count);
+        for(size_t i = 0; i < count; ++i)
+            dest[i] += reference;
+        return HEADER_SIZE + count * width;
+    }
+
+    /**
+     * \brief Inclusive prefix sum in place: values[i] = base + values[0] + ... + values[i]
+     * \param values Values to accumulate
+     * \param count Number of values
+     * \param base Value added to every element
+     */
+    static void PREFIX_SUM_64(uint64_t* values, const size_t count, const uint64_t base)
+    {
+        size_t i = 0;
+        uint64_t carry = base;
+        // The lanes are scanned without the carry, then the carry grows by the total of the lanes: the only
+        // dependency between iterations is one add, instead of one add per value for the scalar loop
+    #if defined(LIBENDIAN_HAS_AVX2)
+        // Four lanes, in two log steps: [a, b, c, d] -> [a, a + b, b + c, c + d] -> [a, a + b, a + b + c, a + b + c + d]
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i vcarry = _mm256_set1_epi64x(int64_t(base));
+        for(; i + 4 <= count; i += 4)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+            x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)), zero, 0x03));
+            x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)), zero, 0x0F));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), _mm256_add_epi64(x, vcarry));
+            vcarry = _mm256_add_epi64(vcarry, _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3)));
+        }
+        if(i)
+            carry = values[i - 1];
+    #elif defined(LIBENDIAN_HAS_SSE2)
+        // Two lanes: [a, b] -> [a, a + b]
+        __m128i vcarry = _mm_set1_epi64x(int64_t(base));
+        for(; i + 2 <= count; i += 2)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+            x = _mm_add_epi64(x, _mm_slli_si128(x, 8));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), _mm_add_epi64(x, vcarry));
+            vcarry = _mm_add_epi64(vcarry, _mm_unpackhi_epi64(x, x));
+        }
+        if(i)
+            carry = values[i - 1];
+    #endif
+        for(; i < count; ++i)
+        {
+            carry += values[i];
+            values[i] = carry;
+        }
+    }
+
+private:
+    /** Number of offsets widened, then summed by DECODE_DELTA_64, at a time */
+    static const size_t BLOCK_SIZE = 256;
+
+    /** Widths written by ENCODE_DELTA_64 and ENCODE_FOR_64 */
+    static bool IS_VALID_WIDTH(const uint8_t width) { return width <= 8 && (width & (width - 1)) == 0; }
+
+    static uint64_t MAX_DELTA(const uint64_t* src, const size_t count)
+    {
+        uint64_t max = 0;
+        for(size_t i = 1; i < count; ++i)
+        {
+            const uint64_t delta = src[i] - src[i - 1];
+            max = delta > max ? delta : max;
+        }
+        return max;
+    }
+
+    static void MIN_MAX(const uint64_t* src, const size_t count, uint64_t& min, uint64_t& max)
+    {
+        min = src[0];
+        max = src[0];
+        for(size_t i = 1; i < count; ++i)
+        {
+            min = src[i] < min ? src[i] : min;
+            max = src[i] > max ? src[i] : max;
+        }
+    }
+
+    static void WRITE_OFFSET(uint8_t* buf, const uint8_t width, const uint64_t value)
+    {
+        switch(width)
+        {
+        case 1: Endian::SET_UINT8(buf, uint8_t(value)); break;
+        case 2: Endian::SET_UINT16(buf, uint16_t(value)); break;
+        case 4: Endian::SET_UINT32(buf, uint32_t(value)); break;
+        case 8: Endian::SET_UINT64(buf, value); break;
+        default: break;
+        }
+    }
+
+    // One loop per width so the width test is hoisted out of the hot loop. Width is 0 or valid
+    static void READ_OFFSETS(uint64_t* dest, const uint8_t* src, const uint8_t width, const size_t count)
+    {
+        switch(width)
+        {
+        case 1: for(size_t i = 0; i < count; ++i) dest[i] = src[i]; break;
+        case 2: WIDEN<uint16_t>(dest, src, count); break;
+        case 4: WIDEN<uint32_t>(dest, src, count); break;
+        case 8: Endian::MEMCPY_64(reinterpret_cast<uint8_t*>(dest), src, count, STORE_CACHED); break;
+        default: for(size_t i = 0; i < count; ++i) dest[i] = 0; break;
+        }
+    }
+
+    /** Swap blocks of T offsets with Endian::MEMCPY_xx into a buffer that stays in L1, then widen them with a loop the compiler vectorizes */
+    template<typename T>
+    static void WIDEN(uint64_t* dest, const uint8_t* src, const size_t count)
+    {
+        T block[BLOCK_SIZE];
+        uint8_t* out = reinterpret_cast<uint8_t*>(block);
+        for(size_t begin = 0; begin < count; begin += BLOCK_SIZE)
+        {
+            const size_t n = count - begin < BLOCK_SIZE ? count - begin : BLOCK_SIZE;
+            if(sizeof(T) == UINT16_SIZE)
+                Endian::MEMCPY_16(out, src + begin * sizeof(T), n, STORE_CACHED);
+            else
+                Endian::MEMCPY_32(out, src + begin * sizeof(T), n, STORE_CACHED);
+            for(size_t i = 0; i < n; ++i)
+                dest[begin + i] = block[i];
+        }
+    }
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
@@ -0,0 +1,42 @@
+/**
+ * \file EndianSimd.hpp
+ * \brief Detect the SIMD instruction sets available at compile time, and define the prefetch hint
+ */
+#ifndef __ENDIAN_SIMD_HPP__
+#define __ENDIAN_SIMD_HPP__
+
+// Set by build system when LIBENDIAN_ENABLE_SIMD is OFF. Force the scalar path everywhere.
+#ifndef LIBENDIAN_DISABLE_SIMD
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+/** SSE2 intrinsics are available */
+#define LIBENDIAN_HAS_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__) || defined(__AVX__)
+/** SSSE3 intrinsics (pshufb) are available */
+#define LIBENDIAN_HAS_SSSE3
+#include <tmmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+/** AVX2 intrinsics are available */
+#define LIBENDIAN_HAS_AVX2
+#include <immintrin.h>
+#endif
+
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+/** Hint the cpu to load the cache line of ptr for a read */
+#define LIBENDIAN_PREFETCH(ptr) __builtin_prefetch((ptr), 0, 3)
+#elif defined(LIBENDIAN_HAS_SSE2)
+/** Hint the cpu to load the cache line of ptr for a read */
+#define LIBENDIAN_PREFETCH(ptr) _mm_prefetch(reinterpret_cast<const char*>(ptr), _MM_HINT_T0)
+#else
+/** Hint the cpu to load the cache line of ptr for a read */
+#define LIBENDIAN_PREFETCH(ptr) ((void)(ptr))
+#endif
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * \file EndianSpan.hpp
+ * \brief Non owning view over a serialized array, decoded lazily element by element
+ */
+#ifndef __ENDIAN_SPAN_HPP__
+#define __ENDIAN_SPAN_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianTraits.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief View over count T serialized with Endian (BigEndian or LittleEndian), without copy.
+ *
+ * Elements are decoded when they are read, with EndianTraits<Endian, T>::GET. Touching a few elements of a
+ * big array, or running std::lower_bound, std::accumulate, std::find... over it never materialize a decoded
+ * copy. When Endian is the host order a read is a plain unaligned load, and native() give the array itself
+ * when it is aligned for T.
+ *
+ * Iterators are random access, but dereference return a T by value: they can't be used to modify the array.
+ *
+ * \code
+ * const EndianSpan<uint32_t, BigEndian> keys(buf, count);
+ * const auto it = std::lower_bound(keys.begin(), keys.end(), 1234u);
+ * const uint64_t total = std::accumulate(keys.begin(), keys.end(), uint64_t(0));
+ * \endcode
+ */
+template<typename T, class Endian>
+class EndianSpan
+{
+public:
+    typedef EndianTraits<Endian, T> Traits;
+    static const size_t ELEMENT_SIZE = Traits::SIZE;
+
+    /** \brief Random access iterator that decode on dereference */
+    class Iterator
+    {
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef T reference;
+
+        Iterator(const uint8_t* buf = nullptr) : _buf(buf) {}
+
+        T operator*() const { return READ(_buf); }
+        T operator[](const difference_type n) const { return READ(_buf + n * difference_type(ELEMENT_SIZE)); }
+
+        Iterator& operator++() { _buf += ELEMENT_SIZE; return *this; }
+        Iterator operator++(int) { Iterator it = *this; _buf += ELEMENT_SIZE; return it; }
+        Iterator& operator--() { _buf -= ELEMENT_SIZE; return *this; }
+        Iterator operator--(int) { Iterator it = *this; _buf -= ELEMENT_SIZE; return it; }
+        Iterator& operator+=(const difference_type n) { _buf += n * difference_type(ELEMENT_SIZE); return *this; }
+        Iterator& operator-=(const difference_type n) { _buf -= n * difference_type(ELEMENT_SIZE); return *this; }
+        Iterator operator+(const difference_type n) const { return Iterator(_buf + n * difference_type(ELEMENT_SIZE)); }
+        Iterator operator-(const difference_type n) const { return Iterator(_buf - n * difference_type(ELEMENT_SIZE)); }
+        friend Iterator operator+(const difference_type n, const Iterator& it) { return it + n; }
+        difference_type operator-(const Iterator& other) const { return (_buf - other._buf) / difference_type(ELEMENT_SIZE); }
+
+        bool operator==(const Iterator& other) const { return _buf == other._buf; }
+        bool operator!=(const Iterator& other) const { return _buf != other._buf; }
+        bool operator<(const Iterator& other) const { return _buf < other._buf; }
+        bool operator>(const Iterator& other) const { return _buf > other._buf; }
+        bool operator<=(const Iterator& other) const { return _buf <= other._buf; }
+        bool operator>=(const Iterator& other) const { return _buf >= other._buf; }
+
+        /** Pointer to the serialized element */
+        const uint8_t* data() const { return _buf; }
+
+    private:
+        const uint8_t* _buf;
+    };
+
+    typedef Iterator iterator;
+    typedef Iterator const_iterator;
+    typedef T value_type;
+    typedef size_t size_type;
+
+    EndianSpan() : _buf(nullptr), _count(0) {}
+
+    /**
+     * \param buf Pointer to the first serialized element, not copied
+     * \param count Number of elements
+     */
+    EndianSpan(const uint8_t* buf, const size_t count) : _buf(buf), _count(count) {}
+
+    /** Number of elements */
+    size_t size() const { return _count; }
+    /** Size of the serialized array (in bytes) */
+    size_t sizeBytes() const { return _count * ELEMENT_SIZE; }
+    bool empty() const { return !_count; }
+    /** Pointer to the serialized array */
+    const uint8_t* data() const { return _buf; }
+
+    Iterator begin() const { return Iterator(_buf); }
+    Iterator end() const { return Iterator(_buf + sizeBytes()); }
+
+    /** Decode element index, that must be less than size() */
+    T operator[](const size_t index) const { return READ(_buf + index * ELEMENT_SIZE); }
+    T front() const { return READ(_buf); }
+    T back() const { return READ(_buf + (_count - 1) * ELEMENT_SIZE); }
+
+    /** View over count elements starting at offset */
+    EndianSpan subspan(const size_t offset, const size_t count) const { return EndianSpan(_buf + offset * ELEMENT_SIZE, count); }
+
+    /** True if elements don't need to be decoded: Endian is the host order */
+    static bool IS_NATIVE()
+    {
+        return Endian::IS_HOST_ORDER || ELEMENT_SIZE == 1;
+    }
+
+    /** The array as native T, if it is in host order and aligned for T. nullptr otherwise */
+    const T* native() const
+    {
+        if(!IS_NATIVE() || uintptr_t(_buf) % alignof(T))
+            return nullptr;
+        return reinterpret_cast<const T*>(_buf);
+    }
+
+private:
+    static T READ(const uint8_t* buf)
+    {
+        if(IS_NATIVE())
+        {
+            T value;
+            memcpy(&value, buf, sizeof(T));
+            return value;
+        }
+        return Traits::GET(buf);
+    }
+
+    const uint8_t* _buf;
+    size_t _count;
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
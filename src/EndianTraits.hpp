@@ -0,0 +1,152 @@
+/**
+ * \file EndianTraits.hpp
+ * \brief Map a C++ type to the GET_xx/SET_xx functions of a byte order class
+ */
+#ifndef __ENDIAN_TRAITS_HPP__
+#define __ENDIAN_TRAITS_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Serialize a T with Endian (BigEndian or LittleEndian) from generic code.
+ * Specialized for every type of the library, except the 48 bits types that have no C++ counterpart.
+ * Signed and floating types go through the unsigned functions of the same width.
+ */
+template<class Endian, typename T>
+struct EndianTraits;
+
+/** \brief EndianTraits for uint8_t */
+template<class Endian>
+struct EndianTraits<Endian, uint8_t>
+{
+    static const size_t SIZE = 1;
+    static uint8_t GET(const uint8_t* buf) { return Endian::GET_UINT8(buf); }
+    static void SET(uint8_t* buf, const uint8_t val) { Endian::SET_UINT8(buf, val); }
+};
+
+/** \brief EndianTraits for uint16_t */
+template<class Endian>
+struct EndianTraits<Endian, uint16_t>
+{
+    static const size_t SIZE = 2;
+    static uint16_t GET(const uint8_t* buf) { return Endian::GET_UINT16(buf); }
+    static void SET(uint8_t* buf, const uint16_t val) { Endian::SET_UINT16(buf, val); }
+};
+
+/** \brief EndianTraits for uint32_t */
+template<class Endian>
+struct EndianTraits<Endian, uint32_t>
+{
+    static const size_t SIZE = 4;
+    static uint32_t GET(const uint8_t* buf) { return Endian::GET_UINT32(buf); }
+    static void SET(uint8_t* buf, const uint32_t val) { Endian::SET_UINT32(buf, val); }
+};
+
+/** \brief EndianTraits for uint64_t */
+template<class Endian>
+struct EndianTraits<Endian, uint64_t>
+{
+    static const size_t SIZE = 8;
+    static uint64_t GET(const uint8_t* buf) { return Endian::GET_UINT64(buf); }
+    static void SET(uint8_t* buf, const uint64_t val) { Endian::SET_UINT64(buf, val); }
+};
+
+/** \brief EndianTraits for int8_t */
+template<class Endian>
+struct EndianTraits<Endian, int8_t>
+{
+    static const size_t SIZE = 1;
+    static int8_t GET(const uint8_t* buf) { return int8_t(Endian::GET_UINT8(buf)); }
+    static void SET(uint8_t* buf, const int8_t val) { Endian::SET_UINT8(buf, uint8_t(val)); }
+};
+
+/** \brief EndianTraits for int16_t */
+template<class Endian>
+struct EndianTraits<Endian, int16_t>
+{
+    static const size_t SIZE = 2;
+    static int16_t GET(const uint8_t* buf) { return int16_t(Endian::GET_UINT16(buf)); }
+    static void SET(uint8_t* buf, const int16_t val) { Endian::SET_UINT16(buf, uint16_t(val)); }
+};
+
+/** \brief EndianTraits for int32_t */
+template<class Endian>
+struct EndianTraits<Endian, int32_t>
+{
+    static const size_t SIZE = 4;
+    static int32_t GET(const uint8_t* buf) { return int32_t(Endian::GET_UINT32(buf)); }
+    static void SET(uint8_t* buf, const int32_t val) { Endian::SET_UINT32(buf, uint32_t(val)); }
+};
+
+/** \brief EndianTraits for int64_t */
+template<class Endian>
+struct EndianTraits<Endian, int64_t>
+{
+    static const size_t SIZE = 8;
+    static int64_t GET(const uint8_t* buf) { return int64_t(Endian::GET_UINT64(buf)); }
+    static void SET(uint8_t* buf, const int64_t val) { Endian::SET_UINT64(buf, uint64_t(val)); }
+};
+
+/** \brief EndianTraits for float */
+template<class Endian>
+struct EndianTraits<Endian, float>
+{
+    static const size_t SIZE = 4;
+    static float GET(const uint8_t* buf)
+    {
+        const uint32_t bits = Endian::GET_UINT32(buf);
+        float val;
+        memcpy(&val, &bits, sizeof(val));
+        return val;
+    }
+    static void SET(uint8_t* buf, const float val)
+    {
+        uint32_t bits;
+        memcpy(&bits, &val, sizeof(bits));
+        Endian::SET_UINT32(buf, bits);
+    }
+};
+
+/** \brief EndianTraits for double */
+template<class Endian>
+struct EndianTraits<Endian, double>
+{
+    static const size_t SIZE = 8;
+    static double GET(const uint8_t* buf)
+    {
+        const uint64_t bits = Endian::GET_UINT64(buf);
+        double val;
+        memcpy(&val, &bits, sizeof(val));
+        return val;
+    }
+    static void SET(uint8_t* buf, const double val)
+    {
+        uint64_t bits;
+        memcpy(&bits, &val, sizeof(bits));
+        Endian::SET_UINT64(buf, bits);
+    }
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
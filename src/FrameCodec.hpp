@@ -0,0 +1,249 @@
+/**
+ * \file FrameCodec.hpp
+ * \brief Split a byte stream into length prefixed frames, a whole receive buffer at a time
+ */
+#ifndef __FRAME_CODEC_HPP__
+#define __FRAME_CODEC_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/** \brief One complete frame, pointing inside the receive buffer */
+struct LIBENDIAN_API_ Frame
+{
+    /** Pointer to the first byte of the frame */
+    const uint8_t* data;
+    /** Size of the frame (in bytes) */
+    size_t size;
+};
+
+/**
+ * \brief Length prefixed framing: a prefix of 1, 2, 4 or 8 bytes serialized with Endian (BigEndian or LittleEndian)
+ * followed by the payload.
+ *
+ * The payload size is the prefix value plus lengthAdjustment. Protocols whose length count the prefix itself
+ * use an adjustment of -prefixSize. Frames whose payload is bigger than maxFrameSize (or negative) are a
+ * protocol error: the codec become invalid, since the stream can't be resynchronized.
+ */
+template<class Endian>
+class FrameCodec : public LibEndian
+{
+public:
+    /**
+     * \param prefixSize Size of the length prefix: 1, 2, 4 or 8 bytes
+     * \param maxFrameSize Biggest accepted payload (in bytes)
+     * \param lengthAdjustment Added to the prefix value to get the payload size
+     * \param includePrefix If true the returned frames start at the prefix, otherwise at the payload
+     */
+    FrameCodec(const uint8_t prefixSize = UINT32_SIZE, const size_t maxFrameSize = 1 << 20,
+        const int64_t lengthAdjustment = 0, const bool includePrefix = false) :
+        _prefixSize(prefixSize), _maxFrameSize(maxFrameSize), _lengthAdjustment(lengthAdjustment),
+        _includePrefix(includePrefix), _valid(prefixSize == 1 || prefixSize == 2 || prefixSize == 4 || prefixSize == 8) {}
+
+    /** Size of the length prefix (in bytes) */
+    uint8_t prefixSize() const { return _prefixSize; }
+    /** Biggest accepted payload (in bytes) */
+    size_t maxFrameSize() const { return _maxFrameSize; }
+    /** False once a prefix announced an invalid payload size, or if the prefix size isn't supported */
+    bool isValid() const { return _valid; }
+
+    /**
+     * \brief Find every complete frame of buf
+     * \param buf Received bytes, starting at a frame boundary
+     * \param size Number of bytes in buf
+     * \param frames Receive at most capacity frames, that point inside buf
+     * \param capacity Size of frames
+     * \param consumed Receive the number of bytes used by the returned frames. The bytes after it are the start
+     * of a partial frame, or frames that didn't fit in frames
+     * \return Number of frames found
+     */
+    size_t decode(const uint8_t* buf, const size_t size, Frame* frames, const size_t capacity, size_t& consumed)
+    {
+        size_t count = 0;
+        size_t position = 0;
+        while(_valid && count < capacity && size - position >= _prefixSize)
+        {
+            const uint8_t* prefix = buf + position;
+            const size_t frame = frameSize(prefix);
+            if(!frame)
+            {
+                _valid = false;
+                break;
+            }
+            if(frame > size - position)
+                break;
+            frames[count].data = _includePrefix ? prefix : prefix + _prefixSize;
+            frames[count].size = _includePrefix ? frame : frame - _prefixSize;
+            ++count;
+            position += frame;
+        }
+        consumed = position;
+        return count;
+    }
+
+    /**
+     * \brief Write the prefix of a payload of size bytes
+     * \param dest Buffer of at least prefixSize() bytes
+     * \return false if size can't be announced with this codec
+     */
+    bool encodePrefix(uint8_t* dest, const size_t size) const
+    {
+        const int64_t value = int64_t(size) - _lengthAdjustment;
+        if(!_valid || size > _maxFrameSize || value < 0 || (_prefixSize < 8 && uint64_t(value) >> (8 * _prefixSize)))
+            return false;
+        switch(_prefixSize)
+        {
+        case 1: Endian::SET_UINT8(dest, uint8_t(value)); break;
+        case 2: Endian::SET_UINT16(dest, uint16_t(value)); break;
+        case 4: Endian::SET_UINT32(dest, uint32_t(value)); break;
+        default: Endian::SET_UINT64(dest, uint64_t(value)); break;
+        }
+        return true;
+    }
+
+    /**
+     * \brief Size of the frame announced by a prefix, prefix included
+     * \param prefix At least prefixSize() bytes
+     * \return 0 if the payload size is invalid
+     */
+    size_t frameSize(const uint8_t* prefix) const
+    {
+        uint64_t value;
+        switch(_prefixSize)
+        {
+        case 1: value = Endian::GET_UINT8(prefix); break;
+        case 2: value = Endian::GET_UINT16(prefix); break;
+        case 4: value = Endian::GET_UINT32(prefix); break;
+        default: value = Endian::GET_UINT64(prefix); break;
+        }
+        // Checked without overflow: a 64 bits prefix can announce anything
+        if(value > uint64_t(INT64_MAX) - (_lengthAdjustment > 0 ? uint64_t(_lengthAdjustment) : 0))
+            return 0;
+        const int64_t payload = int64_t(value) + _lengthAdjustment;
+        if(payload < 0 || uint64_t(payload) > _maxFrameSize)
+            return 0;
+        return _prefixSize + size_t(payload);
+    }
+
+private:
+    uint8_t _prefixSize;
+    size_t _maxFrameSize;
+    int64_t _lengthAdjustment;
+    bool _includePrefix;
+    bool _valid;
+};
+
+/**
+ * \brief Receive buffer that hand out the complete frames of every burst in one batch.
+ *
+ * \code
+ * FrameReceiver<BigEndian> receiver(FrameCodec<BigEndian>(2));
+ * Frame frames[64];
+ * for(;;)
+ * {
+ *     const ssize_t n = recv(fd, receiver.receiveBuffer(), receiver.receiveCapacity(), 0);
+ *     receiver.received(n);
+ *     while(const size_t count = receiver.frames(frames, 64))
+ *         for(size_t i = 0; i < count; ++i)
+ *             dispatch(frames[i].data, frames[i].size);
+ *     if(!receiver.isValid())
+ *         break;
+ * }
+ * \endcode
+ *
+ * Frames are never copied. They stay valid until the next receiveBuffer(), that move the partial frame left
+ * at the end of the buffer to its start.
+ */
+template<class Endian>
+class FrameReceiver
+{
+public:
+    /**
+     * \param codec Framing of the stream
+     * \param capacity Initial size of the buffer (in bytes), it grows up to the size of the biggest frame
+     */
+    FrameReceiver(const FrameCodec<Endian>& codec = FrameCodec<Endian>(), const size_t capacity = 64 * 1024) :
+        _codec(codec), _buffer(capacity ? capacity : 1), _begin(0), _end(0) {}
+
+    /** False once the stream contained an invalid frame */
+    bool isValid() const { return _codec.isValid(); }
+    /** Number of received bytes not returned as frames yet */
+    size_t pending() const { return _end - _begin; }
+
+    /**
+     * \brief Where to write the next received bytes, at most receiveCapacity().
+     * Invalidate the frames previously returned.
+     */
+    uint8_t* receiveBuffer()
+    {
+        if(_begin)
+        {
+            memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+            _end -= _begin;
+            _begin = 0;
+        }
+        // Make room for the whole pending frame, or at least for one more byte
+        size_t needed = _end + 1;
+        if(_end >= _codec.prefixSize())
+        {
+            const size_t frame = _codec.frameSize(_buffer.data());
+            if(frame > needed)
+                needed = frame;
+        }
+        if(needed > _buffer.size())
+            _buffer.resize(needed > 2 * _buffer.size() ? needed : 2 * _buffer.size());
+        return _buffer.data() + _end;
+    }
+
+    /** Number of bytes that can be written at receiveBuffer() */
+    size_t receiveCapacity() const { return _buffer.size() - _end; }
+
+    /** Commit size bytes written at receiveBuffer() */
+    void received(const size_t size) { _end += size; }
+
+    /**
+     * \brief Return the complete frames received so far
+     * \param frames Receive at most capacity frames
+     * \param capacity Size of frames
+     * \return Number of frames, 0 if no complete frame is pending
+     */
+    size_t frames(Frame* frames, const size_t capacity)
+    {
+        size_t consumed;
+        const size_t count = _codec.decode(_buffer.data() + _begin, _end - _begin, frames, capacity, consumed);
+        _begin += consumed;
+        if(_begin == _end)
+            _begin = _end = 0;
+        return count;
+    }
+
+private:
+    FrameCodec<Endian> _codec;
+    std::vector<uint8_t> _buffer;
+    size_t _begin;
+    size_t _end;
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
@@ -0,0 +1,318 @@
+/**
+ * \file GorillaCoding.hpp
+ * \brief XOR compression of floating point time series, as in Facebook Gorilla
+ */
+#ifndef __GORILLA_CODING_HPP__
+#define __GORILLA_CODING_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <BigEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Bit stream shared by GorillaEncoder and GorillaDecoder.
+ * Bits are written most significant first, and bytes in order, so the stream is the same on every host.
+ */
+class LIBENDIAN_API_ GorillaBits
+{
+public:
+    /** Bits used by a float or a double */
+    template<typename T>
+    struct Format
+    {
+        static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value, "Only float and double are supported");
+        typedef typename std::conditional<sizeof(T) == 4, uint32_t, uint64_t>::type Bits;
+        /** Number of bits of a value */
+        static const unsigned SIZE = sizeof(T) * 8;
+        /** Number of bits that store the count of leading zeros, capped to 31 */
+        static const unsigned LEADING_BITS = 5;
+        /** Number of bits that store the count of meaningful bits, SIZE is stored as 0 */
+        static const unsigned LENGTH_BITS = sizeof(T) == 4 ? 5 : 6;
+    };
+
+    static unsigned LEADING_ZEROS(uint64_t x, const unsigned size)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return unsigned(__builtin_clzll(x)) - (64 - size);
+    #else
+        unsigned count = 0;
+        for(uint64_t bit = uint64_t(1) << (size - 1); !(x & bit); bit >>= 1)
+            ++count;
+        return count;
+    #endif
+    }
+
+    static unsigned TRAILING_ZEROS(uint64_t x)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return unsigned(__builtin_ctzll(x));
+    #else
+        unsigned count = 0;
+        for(; !(x & 1); x >>= 1)
+            ++count;
+        return count;
+    #endif
+    }
+};
+
+/**
+ * \brief Compress a stream of float or double.
+ *
+ * The first value is stored on 32 or 64 bits. Each following value is XORed with the previous one, then:
+ * - '0' if it is equal.
+ * - '10' followed by the meaningful bits, if they fit in the window of leading and trailing zeros of the previous '11'.
+ * - '11', 5 bits of leading zeros, 6 bits (5 for float) of meaningful length, then the meaningful bits.
+ *
+ * Slowly changing series take one bit or a few bytes per value instead of 8.
+ * The number of values isn't stored, the decoder must know it.
+ */
+template<typename T>
+class GorillaEncoder
+{
+public:
+    typedef GorillaBits::Format<T> Format;
+    typedef typename Format::Bits Bits;
+
+    GorillaEncoder() { clear(); }
+
+    /** Append a value to the stream */
+    void append(const T value)
+    {
+        Bits bits;
+        memcpy(&bits, &value, sizeof(bits));
+        if(!_count++)
+        {
+            write(bits, Format::SIZE);
+            _previous = bits;
+            return;
+        }
+
+        const Bits x = bits ^ _previous;
+        _previous = bits;
+        if(!x)
+        {
+            write(0, 1);
+            return;
+        }
+
+        unsigned leading = GorillaBits::LEADING_ZEROS(x, Format::SIZE);
+        if(leading > 31)
+            leading = 31;
+        const unsigned trailing = GorillaBits::TRAILING_ZEROS(x);
+
+        if(_leading != NO_WINDOW && leading >= _leading && trailing >= _trailing)
+        {
+            write(0x2, 2);
+            write(x >> _trailing, Format::SIZE - _leading - _trailing);
+            return;
+        }
+
+        const unsigned length = Format::SIZE - leading - trailing;
+        write(0x3, 2);
+        write(leading, Format::LEADING_BITS);
+        write(length % Format::SIZE, Format::LENGTH_BITS);
+        write(x >> trailing, length);
+        _leading = leading;
+        _trailing = trailing;
+    }
+
+    /** Append count values */
+    void append(const T* values, const size_t count)
+    {
+        for(size_t i = 0; i < count; ++i)
+            append(values[i]);
+    }
+
+    /** Flush the last bits, padded with zeros to a whole byte. Call it once before reading data() */
+    void finish()
+    {
+        if(_bits)
+        {
+            _buffer.push_back(uint8_t(_accumulator << (8 - _bits)));
+            _bits = 0;
+            _accumulator = 0;
+        }
+    }
+
+    /** Restart an empty stream */
+    void clear()
+    {
+        _buffer.clear();
+        _accumulator = 0;
+        _bits = 0;
+        _count = 0;
+        _previous = 0;
+        _leading = NO_WINDOW;
+        _trailing = 0;
+    }
+
+    /** Compressed bytes */
+    const uint8_t* data() const { return _buffer.data(); }
+    /** Number of compressed bytes, complete after finish() */
+    size_t size() const { return _buffer.size(); }
+    /** Number of values appended */
+    size_t count() const { return _count; }
+
+private:
+    static const unsigned NO_WINDOW = 0xFF;
+
+    /** Append the n (1 to 64) low bits of value, most significant first */
+    void write(uint64_t value, unsigned n)
+    {
+        if(n > 32)
+        {
+            write(value >> 32, n - 32);
+            value &= 0xFFFFFFFF;
+            n = 32;
+        }
+        _accumulator = (_accumulator << n) | value;
+        _bits += n;
+        while(_bits >= 8)
+        {
+            _bits -= 8;
+            _buffer.push_back(uint8_t(_accumulator >> _bits));
+        }
+    }
+
+    std::vector<uint8_t> _buffer;
+    uint64_t _accumulator;
+    unsigned _bits;
+    size_t _count;
+    Bits _previous;
+    unsigned _leading;
+    unsigned _trailing;
+};
+
+/** \brief Decompress a stream written by GorillaEncoder<T> */
+template<typename T>
+class GorillaDecoder
+{
+public:
+    typedef GorillaBits::Format<T> Format;
+    typedef typename Format::Bits Bits;
+
+    /**
+     * \param data Compressed bytes, not copied
+     * \param size Number of compressed bytes
+     */
+    GorillaDecoder(const uint8_t* data, const size_t size) :
+        _data(data), _size(size), _position(0), _count(0), _previous(0), _leading(0), _trailing(0) {}
+
+    /**
+     * \brief Decode the next value
+     * \return false if the stream is truncated. Padding can't be told apart from values, stop after the known count
+     */
+    bool next(T& value)
+    {
+        Bits bits;
+        if(!_count)
+        {
+            if(!available(Format::SIZE))
+                return false;
+            bits = Bits(read(Format::SIZE));
+        }
+        else
+        {
+            if(!available(1))
+                return false;
+            if(!read(1))
+                bits = _previous;
+            else
+            {
+                if(!available(1))
+                    return false;
+                if(read(1))
+                {
+                    if(!available(Format::LEADING_BITS + Format::LENGTH_BITS))
+                        return false;
+                    _leading = unsigned(read(Format::LEADING_BITS));
+                    unsigned length = unsigned(read(Format::LENGTH_BITS));
+                    if(!length)
+                        length = Format::SIZE;
+                    if(_leading + length > Format::SIZE)
+                        return false;
+                    _trailing = Format::SIZE - _leading - length;
+                }
+                const unsigned length = Format::SIZE - _leading - _trailing;
+                if(!available(length))
+                    return false;
+                bits = _previous ^ Bits(read(length) << _trailing);
+            }
+        }
+        ++_count;
+        _previous = bits;
+        memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+
+    /**
+     * \brief Decode count values
+     * \return Number of values decoded, smaller than count if the stream is truncated
+     */
+    size_t next(T* values, const size_t count)
+    {
+        size_t i = 0;
+        while(i < count && next(values[i]))
+            ++i;
+        return i;
+    }
+
+private:
+    bool available(const unsigned n) const { return _position + n <= _size * 8; }
+
+    /** Read n (1 to 64) bits, most significant first. The caller checked they are available */
+    uint64_t read(unsigned n)
+    {
+        if(n > 56)
+        {
+            const uint64_t high = read(n - 32);
+            return (high << 32) | read(32);
+        }
+        const size_t byte = _position / 8;
+        uint64_t word;
+        if(byte + 8 <= _size)
+            word = BigEndian::GET_UINT64(_data + byte);
+        else
+        {
+            uint8_t tail[8] = {};
+            memcpy(tail, _data + byte, _size - byte);
+            word = BigEndian::GET_UINT64(tail);
+        }
+        const uint64_t value = (word << (_position % 8)) >> (64 - n);
+        _position += n;
+        return value;
+    }
+
+    const uint8_t* _data;
+    size_t _size;
+    size_t _position;
+    size_t _count;
+    Bits _previous;
+    unsigned _leading;
+    unsigned _trailing;
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
@@ -11,6 +11,7 @@
 
 // C Header
 #include <stdint.h>
+#include <stddef.h>
 
 // C++ Header
 
@@ -61,6 +62,11 @@
 #define LIBENDIAN_USING_NAMESPACE
 #endif
 
+/** Set by build system. Size (in bytes) from which bulk conversions use non-temporal stores by default */
+#ifndef LIBENDIAN_STREAMING_THRESHOLD
+#define LIBENDIAN_STREAMING_THRESHOLD (8 * 1024 * 1024)
+#endif
+
 LIBENDIAN_NAMESPACE_START
 
 // ─────────────────────────────────────────────────────────────
@@ -100,6 +106,20 @@ public:
     /** Size of double variable (8 bytes) */
     static const uint8_t FLOAT64_SIZE = 8;
 
+    /** How bulk conversions (MEMCPY_xx) write the destination */
+    enum StoreMode
+    {
+        /** Non-temporal stores from STREAMING_THRESHOLD bytes, cached stores below */
+        STORE_AUTO,
+        /** Always use regular cached stores */
+        STORE_CACHED,
+        /** Always use non-temporal stores, the destination doesn't pollute the caches */
+        STORE_STREAMING
+    };
+
+    /** Size (in bytes) from which STORE_AUTO switch to non-temporal stores */
+    static const size_t STREAMING_THRESHOLD = LIBENDIAN_STREAMING_THRESHOLD;
+
     static bool IS_16_ALIGNED(const uintptr_t ptr) { return ptr % 2 == 0; }
     static bool IS_32_ALIGNED(const uintptr_t ptr) { return ptr % 4 == 0; }
     static bool IS_64_ALIGNED(const uintptr_t ptr) { return ptr % 8 == 0; }
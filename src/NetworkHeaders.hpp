@@ -0,0 +1,400 @@
+/**
+ * \file NetworkHeaders.hpp
+ * \brief Zero-copy views over standard network protocol headers
+ */
+#ifndef __NETWORK_HEADERS_HPP__
+#define __NETWORK_HEADERS_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <BigEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief View over an Ethernet II header (with optional 802.1Q tag)
+ * \note The view doesn't own the buffer and never copies it.
+ * Length must be checked with IS_VALID before any accessor is called.
+ */
+class LIBENDIAN_API_ EthernetHeaderView
+{
+public:
+    /** Size of an untagged ethernet header (14 bytes) */
+    static const uint8_t SIZE = 14;
+    /** Size of an 802.1Q tagged ethernet header (18 bytes) */
+    static const uint8_t VLAN_SIZE = 18;
+    /** EtherType of an 802.1Q tag */
+    static const uint16_t ETHERTYPE_VLAN = 0x8100;
+    /** EtherType of an IPv4 payload */
+    static const uint16_t ETHERTYPE_IPV4 = 0x0800;
+    /** EtherType of an IPv6 payload */
+    static const uint16_t ETHERTYPE_IPV6 = 0x86DD;
+
+    EthernetHeaderView(const uint8_t* buf = nullptr) : _buf(buf) {}
+
+    /**
+     * \brief Check that buf can hold an ethernet header, including the vlan tag if any
+     * \param buf Pointer to the first byte of the frame
+     * \param length Number of bytes available in buf
+     */
+    static bool IS_VALID(const uint8_t* buf, const size_t length)
+    {
+        if(length < SIZE)
+            return false;
+        return BigEndian::GET_UINT16(buf, 12) != ETHERTYPE_VLAN || length >= VLAN_SIZE;
+    }
+
+    /** Pointer to the first byte of the header */
+    const uint8_t* data() const { return _buf; }
+    /** Pointer to the 6 bytes destination MAC address */
+    const uint8_t* destination() const { return _buf; }
+    /** Pointer to the 6 bytes source MAC address */
+    const uint8_t* source() const { return _buf + 6; }
+    /** True if the frame carry an 802.1Q tag */
+    bool isVlanTagged() const { return BigEndian::GET_UINT16(_buf, 12) == ETHERTYPE_VLAN; }
+    /** 12 bits VLAN identifier. Only relevant if isVlanTagged */
+    uint16_t vlanId() const { return BigEndian::GET_UINT16(_buf, 14) & 0x0FFF; }
+    /** 3 bits priority code point. Only relevant if isVlanTagged */
+    uint8_t vlanPriority() const { return BigEndian::GET_UINT8(_buf, 14) >> 5; }
+    /** EtherType of the payload, after the vlan tag if any */
+    uint16_t etherType() const { return BigEndian::GET_UINT16(_buf, isVlanTagged() ? 16 : 12); }
+    /** Length of the header in bytes */
+    uint8_t headerLength() const { return isVlanTagged() ? VLAN_SIZE : SIZE; }
+    /** Pointer to the first byte of the payload */
+    const uint8_t* payload() const { return _buf + headerLength(); }
+
+private:
+    const uint8_t* _buf;
+};
+
+/**
+ * \brief View over an IPv4 header
+ * \note The view doesn't own the buffer and never copies it.
+ * Length must be checked with IS_VALID before any accessor is called.
+ */
+class LIBENDIAN_API_ Ipv4HeaderView
+{
+public:
+    /** Size of an IPv4 header without options (20 bytes) */
+    static const uint8_t SIZE = 20;
+
+    /** Don't fragment flag, as returned by flags() */
+    static const uint8_t FLAG_DF = 0x2;
+    /** More fragments flag, as returned by flags() */
+    static const uint8_t FLAG_MF = 0x1;
+
+    Ipv4HeaderView(const uint8_t* buf = nullptr) : _buf(buf) {}
+
+    /**
+     * \brief Check version, IHL and that buf can hold the whole header with its options
+     * \param buf Pointer to the first byte of the header
+     * \param length Number of bytes available in buf
+     */
+    static bool IS_VALID(const uint8_t* buf, const size_t length)
+    {
+        if(length < SIZE)
+            return false;
+        const uint8_t versionIhl = BigEndian::GET_UINT8(buf);
+        const uint8_t headerLength = (versionIhl & 0x0F) * 4;
+        return (versionIhl >> 4) == 4 && headerLength >= SIZE && length >= headerLength;
+    }
+
+    /** Pointer to the first byte of the header */
+    const uint8_t* data() const { return _buf; }
+    /** Version field, always 4 for a valid header */
+    uint8_t version() const { return BigEndian::GET_UINT8(_buf) >> 4; }
+    /** Internet Header Length, in 32 bits words */
+    uint8_t ihl() const { return BigEndian::GET_UINT8(_buf) & 0x0F; }
+    /** Length of the header with its options in bytes */
+    uint8_t headerLength() const { return ihl() * 4; }
+    /** 6 bits Differentiated Services Code Point */
+    uint8_t dscp() const { return BigEndian::GET_UINT8(_buf, 1) >> 2; }
+    /** 2 bits Explicit Congestion Notification */
+    uint8_t ecn() const { return BigEndian::GET_UINT8(_buf, 1) & 0x03; }
+    /** Length of the whole datagram (header + payload) in bytes */
+    uint16_t totalLength() const { return BigEndian::GET_UINT16(_buf, 2); }
+    /** Identification field */
+    uint16_t identification() const { return BigEndian::GET_UINT16(_buf, 4); }
+    /** 3 bits flags field. See FLAG_DF and FLAG_MF */
+    uint8_t flags() const { return BigEndian::GET_UINT8(_buf, 6) >> 5; }
+    /** True if the don't fragment flag is set */
+    bool dontFragment() const { return (flags() & FLAG_DF) != 0; }
+    /** True if the more fragments flag is set */
+    bool moreFragments() const { return (flags() & FLAG_MF) != 0; }
+    /** Fragment offset in units of 8 bytes */
+    uint16_t fragmentOffset() const { return BigEndian::GET_UINT16(_buf, 6) & 0x1FFF; }
+    /** Time to live */
+    uint8_t ttl() const { return BigEndian::GET_UINT8(_buf, 8); }
+    /** Protocol of the payload (6 for TCP, 17 for UDP) */
+    uint8_t protocol() const { return BigEndian::GET_UINT8(_buf, 9); }
+    /** Header checksum */
+    uint16_t checksum() const { return BigEndian::GET_UINT16(_buf, 10); }
+    /** Source address in host order */
+    uint32_t source() const { return BigEndian::GET_UINT32(_buf, 12); }
+    /** Destination address in host order */
+    uint32_t destination() const { return BigEndian::GET_UINT32(_buf, 16); }
+    /** Pointer to the options, headerLength() - SIZE bytes long */
+    const uint8_t* options() const { return _buf + SIZE; }
+    /** Pointer to the first byte of the payload */
+    const uint8_t* payload() const { return _buf + headerLength(); }
+
+private:
+    const uint8_t* _buf;
+};
+
+/**
+ * \brief View over an IPv6 fixed header
+ * \note The view doesn't own the buffer and never copies it.
+ * Extension headers are not walked, nextHeader() return the first one.
+ */
+class LIBENDIAN_API_ Ipv6HeaderView
+{
+public:
+    /** Size of the IPv6 fixed header (40 bytes) */
+    static const uint8_t SIZE = 40;
+
+    Ipv6HeaderView(const uint8_t* buf = nullptr) : _buf(buf) {}
+
+    /**
+     * \brief Check version and that buf can hold the fixed header
+     * \param buf Pointer to the first byte of the header
+     * \param length Number of bytes available in buf
+     */
+    static bool IS_VALID(const uint8_t* buf, const size_t length)
+    {
+        return length >= SIZE && (BigEndian::GET_UINT8(buf) >> 4) == 6;
+    }
+
+    /** Pointer to the first byte of the header */
+    const uint8_t* data() const { return _buf; }
+    /** Version field, always 6 for a valid header */
+    uint8_t version() const { return BigEndian::GET_UINT8(_buf) >> 4; }
+    /** 8 bits traffic class */
+    uint8_t trafficClass() const { return uint8_t((BigEndian::GET_UINT16(_buf) >> 4) & 0xFF); }
+    /** 20 bits flow label */
+    uint32_t flowLabel() const { return BigEndian::GET_UINT32(_buf) & 0x000FFFFF; }
+    /** Length of the payload (extension headers included) in bytes */
+    uint16_t payloadLength() const { return BigEndian::GET_UINT16(_buf, 4); }
+    /** Type of the next header */
+    uint8_t nextHeader() const { return BigEndian::GET_UINT8(_buf, 6); }
+    /** Hop limit */
+    uint8_t hopLimit() const { return BigEndian::GET_UINT8(_buf, 7); }
+    /** Pointer to the 16 bytes source address */
+    const uint8_t* source() const { return _buf + 8; }
+    /** Pointer to the 16 bytes destination address */
+    const uint8_t* destination() const { return _buf + 24; }
+    /** Pointer to the first byte after the fixed header */
+    const uint8_t* payload() const { return _buf + SIZE; }
+
+private:
+    const uint8_t* _buf;
+};
+
+/**
+ * \brief View over an UDP header
+ * \note The view doesn't own the buffer and never copies it.
+ */
+class LIBENDIAN_API_ UdpHeaderView
+{
+public:
+    /** Size of an UDP header (8 bytes) */
+    static const uint8_t SIZE = 8;
+
+    UdpHeaderView(const uint8_t* buf = nullptr) : _buf(buf) {}
+
+    /**
+     * \brief Check that buf can hold an UDP header
+     * \param buf Pointer to the first byte of the header
+     * \param length Number of bytes available in buf
+     */
+    static bool IS_VALID(const uint8_t*, const size_t length) { return length >= SIZE; }
+
+    /** Pointer to the first byte of the header */
+    const uint8_t* data() const { return _buf; }
+    /** Source port */
+    uint16_t sourcePort() const { return BigEndian::GET_UINT16(_buf); }
+    /** Destination port */
+    uint16_t destinationPort() const { return BigEndian::GET_UINT16(_buf, 2); }
+    /** Length of header + payload in bytes */
+    uint16_t length() const { return BigEndian::GET_UINT16(_buf, 4); }
+    /** Checksum, 0 if not computed */
+    uint16_t checksum() const { return BigEndian::GET_UINT16(_buf, 6); }
+    /** Pointer to the first byte of the payload */
+    const uint8_t* payload() const { return _buf + SIZE; }
+
+private:
+    const uint8_t* _buf;
+};
+
+/**
+ * \brief View over a TCP header
+ * \note The view doesn't own the buffer and never copies it.
+ * Length must be checked with IS_VALID before any accessor is called.
+ */
+class LIBENDIAN_API_ TcpHeaderView
+{
+public:
+    /** Size of a TCP header without options (20 bytes) */
+    static const uint8_t SIZE = 20;
+
+    /** FIN flag, as returned by flags() */
+    static const uint8_t FLAG_FIN = 0x01;
+    /** SYN flag, as returned by flags() */
+    static const uint8_t FLAG_SYN = 0x02;
+    /** RST flag, as returned by flags() */
+    static const uint8_t FLAG_RST = 0x04;
+    /** PSH flag, as returned by flags() */
+    static const uint8_t FLAG_PSH = 0x08;
+    /** ACK flag, as returned by flags() */
+    static const uint8_t FLAG_ACK = 0x10;
+    /** URG flag, as returned by flags() */
+    static const uint8_t FLAG_URG = 0x20;
+    /** ECE flag, as returned by flags() */
+    static const uint8_t FLAG_ECE = 0x40;
+    /** CWR flag, as returned by flags() */
+    static const uint8_t FLAG_CWR = 0x80;
+
+    TcpHeaderView(const uint8_t* buf = nullptr) : _buf(buf) {}
+
+    /**
+     * \brief Check data offset and that buf can hold the whole header with its options
+     * \param buf Pointer to the first byte of the header
+     * \param length Number of bytes available in buf
+     */
+    static bool IS_VALID(const uint8_t* buf, const size_t length)
+    {
+        if(length < SIZE)
+            return false;
+        const uint8_t headerLength = (BigEndian::GET_UINT8(buf, 12) >> 4) * 4;
+        return headerLength >= SIZE && length >= headerLength;
+    }
+
+    /** Pointer to the first byte of the header */
+    const uint8_t* data() const { return _buf; }
+    /** Source port */
+    uint16_t sourcePort() const { return BigEndian::GET_UINT16(_buf); }
+    /** Destination port */
+    uint16_t destinationPort() const { return BigEndian::GET_UINT16(_buf, 2); }
+    /** Sequence number */
+    uint32_t sequenceNumber() const { return BigEndian::GET_UINT32(_buf, 4); }
+    /** Acknowledgment number */
+    uint32_t acknowledgmentNumber() const { return BigEndian::GET_UINT32(_buf, 8); }
+    /** Data offset, in 32 bits words */
+    uint8_t dataOffset() const { return BigEndian::GET_UINT8(_buf, 12) >> 4; }
+    /** Length of the header with its options in bytes */
+    uint8_t headerLength() const { return dataOffset() * 4; }
+    /** 8 bits flags field. See FLAG_* */
+    uint8_t flags() const { return BigEndian::GET_UINT8(_buf, 13); }
+    /** True if FIN is set */
+    bool fin() const { return (flags() & FLAG_FIN) != 0; }
+    /** True if SYN is set */
+    bool syn() const { return (flags() & FLAG_SYN) != 0; }
+    /** True if RST is set */
+    bool rst() const { return (flags() & FLAG_RST) != 0; }
+    /** True if PSH is set */
+    bool psh() const { return (flags() & FLAG_PSH) != 0; }
+    /** True if ACK is set */
+    bool ack() const { return (flags() & FLAG_ACK) != 0; }
+    /** True if URG is set */
+    bool urg() const { return (flags() & FLAG_URG) != 0; }
+    /** True if ECE is set */
+    bool ece() const { return (flags() & FLAG_ECE) != 0; }
+    /** True if CWR is set */
+    bool cwr() const { return (flags() & FLAG_CWR) != 0; }
+    /** Receive window */
+    uint16_t window() const { return BigEndian::GET_UINT16(_buf, 14); }
+    /** Checksum */
+    uint16_t checksum() const { return BigEndian::GET_UINT16(_buf, 16); }
+    /** Urgent pointer */
+    uint16_t urgentPointer() const { return BigEndian::GET_UINT16(_buf, 18); }
+    /** Pointer to the options, headerLength() - SIZE bytes long */
+    const uint8_t* options() const { return _buf + SIZE; }
+    /** Pointer to the first byte of the payload */
+    const uint8_t* payload() const { return _buf + headerLength(); }
+
+private:
+    const uint8_t* _buf;
+};
+
+/** \brief Validate a burst of packets once so header views can be used without further checks */
+class LIBENDIAN_API_ NetworkHeaders
+{
+public:
+    /**
+     * \brief Validate count packets and build a view for each one that holds a valid View header.
+     * Views of valid packets are stored contiguously at the start of views,
+     * and their index in packets is stored in indexes if not null.
+     * \param packets Array of pointers to the first byte of each packet
+     * \param lengths Length in bytes of each packet
+     * \param count Number of packets
+     * \param offset Offset of the header in every packet (in bytes)
+     * \param views Output array of at least count views
+     * \param indexes Optional output array of at least count indexes
+     * \return Number of valid views
+     */
+    template<typename View>
+    static size_t PARSE_BURST(const uint8_t* const* packets, const size_t* lengths, const size_t count,
+        const size_t offset, View* views, size_t* indexes = nullptr)
+    {
+        size_t valid = 0;
+        for(size_t i = 0; i < count; ++i)
+        {
+            if(lengths[i] < offset || !View::IS_VALID(packets[i] + offset, lengths[i] - offset))
+                continue;
+            views[valid] = View(packets[i] + offset);
+            if(indexes)
+                indexes[valid] = i;
+            ++valid;
+        }
+        return valid;
+    }
+
+    /**
+     * \brief Validate count packets of stride bytes stored contiguously, like in a receive ring.
+     * \param buf Pointer to the first packet
+     * \param stride Distance between two packets (in bytes)
+     * \param lengths Length in bytes of each packet
+     * \param count Number of packets
+     * \param offset Offset of the header in every packet (in bytes)
+     * \param views Output array of at least count views
+     * \param indexes Optional output array of at least count indexes
+     * \return Number of valid views
+     */
+    template<typename View>
+    static size_t PARSE_BURST_STRIDED(const uint8_t* buf, const size_t stride, const size_t* lengths, const size_t count,
+        const size_t offset, View* views, size_t* indexes = nullptr)
+    {
+        size_t valid = 0;
+        for(size_t i = 0; i < count; ++i)
+        {
+            const uint8_t* packet = buf + i * stride;
+            if(lengths[i] < offset || !View::IS_VALID(packet + offset, lengths[i] - offset))
+                continue;
+            views[valid] = View(packet + offset);
+            if(indexes)
+                indexes[valid] = i;
+            ++valid;
+        }
+        return valid;
+    }
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
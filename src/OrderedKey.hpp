@@ -0,0 +1,257 @@
+/**
+ * \file OrderedKey.hpp
+ * \brief Encode values so that the encoded keys sort with memcmp
+ */
+#ifndef __ORDERED_KEY_HPP__
+#define __ORDERED_KEY_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <BigEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Order preserving encoding: a < b if and only if memcmp(key(a), key(b)) < 0.
+ *
+ * Every value is stored big endian, most significant byte first, after a transform:
+ * - Unsigned integers are stored as is.
+ * - Signed integers have their sign bit flipped, so negative values come first.
+ * - float and double use the IEEE total order: the sign bit is flipped for positive values and
+ *   every bit is flipped for negative ones. -0 sort before +0, and NaN sort at both ends depending on their sign.
+ *
+ * Builder concatenate several fields into a composite key, each field can be ascending or descending.
+ */
+class LIBENDIAN_API_ OrderedKey : public LibEndian
+{
+public:
+    /** Write the key of a value (UINTxx_SIZE/INTxx_SIZE/FLOATxx_SIZE bytes) */
+    static void SET_UINT8(uint8_t* buf, const uint8_t val) { BigEndian::SET_UINT8(buf, val); }
+    static void SET_UINT16(uint8_t* buf, const uint16_t val) { BigEndian::SET_UINT16(buf, val); }
+    static void SET_UINT32(uint8_t* buf, const uint32_t val) { BigEndian::SET_UINT32(buf, val); }
+    static void SET_UINT64(uint8_t* buf, const uint64_t val) { BigEndian::SET_UINT64(buf, val); }
+    static void SET_INT8(uint8_t* buf, const int8_t val) { BigEndian::SET_UINT8(buf, ENCODE(val)); }
+    static void SET_INT16(uint8_t* buf, const int16_t val) { BigEndian::SET_UINT16(buf, ENCODE(val)); }
+    static void SET_INT32(uint8_t* buf, const int32_t val) { BigEndian::SET_UINT32(buf, ENCODE(val)); }
+    static void SET_INT64(uint8_t* buf, const int64_t val) { BigEndian::SET_UINT64(buf, ENCODE(val)); }
+    static void SET_FLOAT32(uint8_t* buf, const float val) { BigEndian::SET_UINT32(buf, ENCODE(val)); }
+    static void SET_FLOAT64(uint8_t* buf, const double val) { BigEndian::SET_UINT64(buf, ENCODE(val)); }
+
+    /** Read back the value of a key */
+    static uint8_t GET_UINT8(const uint8_t* buf) { return BigEndian::GET_UINT8(buf); }
+    static uint16_t GET_UINT16(const uint8_t* buf) { return BigEndian::GET_UINT16(buf); }
+    static uint32_t GET_UINT32(const uint8_t* buf) { return BigEndian::GET_UINT32(buf); }
+    static uint64_t GET_UINT64(const uint8_t* buf) { return BigEndian::GET_UINT64(buf); }
+    static int8_t GET_INT8(const uint8_t* buf) { return DECODE<int8_t>(BigEndian::GET_UINT8(buf)); }
+    static int16_t GET_INT16(const uint8_t* buf) { return DECODE<int16_t>(BigEndian::GET_UINT16(buf)); }
+    static int32_t GET_INT32(const uint8_t* buf) { return DECODE<int32_t>(BigEndian::GET_UINT32(buf)); }
+    static int64_t GET_INT64(const uint8_t* buf) { return DECODE<int64_t>(BigEndian::GET_UINT64(buf)); }
+    static float GET_FLOAT32(const uint8_t* buf) { return DECODE<float>(BigEndian::GET_UINT32(buf)); }
+    static double GET_FLOAT64(const uint8_t* buf) { return DECODE<double>(BigEndian::GET_UINT64(buf)); }
+
+    /**
+     * \brief Encode count values packed one after the other
+     * \param dest Buffer of count * sizeof(T) bytes
+     * \param src Values to encode
+     * \param count Number of values
+     */
+    static void SET_UINT32_ARRAY(uint8_t* dest, const uint32_t* src, const size_t count) { BigEndian::MEMCPY_32(dest, (const uint8_t*)src, count); }
+    static void SET_UINT64_ARRAY(uint8_t* dest, const uint64_t* src, const size_t count) { BigEndian::MEMCPY_64(dest, (const uint8_t*)src, count); }
+    static void SET_INT32_ARRAY(uint8_t* dest, const int32_t* src, const size_t count) { SET_ARRAY(dest, src, count); }
+    static void SET_INT64_ARRAY(uint8_t* dest, const int64_t* src, const size_t count) { SET_ARRAY(dest, src, count); }
+    static void SET_FLOAT32_ARRAY(uint8_t* dest, const float* src, const size_t count) { SET_ARRAY(dest, src, count); }
+    static void SET_FLOAT64_ARRAY(uint8_t* dest, const double* src, const size_t count) { SET_ARRAY(dest, src, count); }
+
+    /**
+     * \brief Decode count values packed one after the other
+     * \param dest Receive count values
+     * \param src Buffer of count * sizeof(T) bytes
+     * \param count Number of values
+     */
+    static void GET_UINT32_ARRAY(uint32_t* dest, const uint8_t* src, const size_t count) { BigEndian::MEMCPY_32((uint8_t*)dest, src, count); }
+    static void GET_UINT64_ARRAY(uint64_t* dest, const uint8_t* src, const size_t count) { BigEndian::MEMCPY_64((uint8_t*)dest, src, count); }
+    static void GET_INT32_ARRAY(int32_t* dest, const uint8_t* src, const size_t count) { GET_ARRAY(dest, src, count); }
+    static void GET_INT64_ARRAY(int64_t* dest, const uint8_t* src, const size_t count) { GET_ARRAY(dest, src, count); }
+    static void GET_FLOAT32_ARRAY(float* dest, const uint8_t* src, const size_t count) { GET_ARRAY(dest, src, count); }
+    static void GET_FLOAT64_ARRAY(double* dest, const uint8_t* src, const size_t count) { GET_ARRAY(dest, src, count); }
+
+    /**
+     * \brief Build a composite key in a caller provided buffer.
+     *
+     * Fields are appended one after the other. A descending field has all its bytes complemented.
+     * Variable length fields (BYTES, TEXT) escape 0x00 as 0x00 0xFF and end with 0x00 0x01,
+     * so that a field never compare with the beginning of the next one.
+     * Nothing is written past capacity: once a field doesn't fit, isValid() return false.
+     *
+     * \code
+     * uint8_t key[64];
+     * OrderedKey::Builder builder(key, sizeof(key));
+     * builder.TEXT("sensor").INT64(timestamp, true).FLOAT64(value);
+     * \endcode
+     */
+    class Builder
+    {
+    public:
+        /**
+         * \param buf Buffer that receive the key
+         * \param capacity Size of buf (in bytes)
+         */
+        Builder(uint8_t* buf, const size_t capacity) : _buf(buf), _capacity(capacity), _size(0), _valid(true) {}
+
+        /** Append an uint8_t */
+        Builder& UINT8(const uint8_t val, const bool descending = false) { return fixed<uint8_t>(val, descending); }
+        /** Append an uint16_t */
+        Builder& UINT16(const uint16_t val, const bool descending = false) { return fixed<uint16_t>(val, descending); }
+        /** Append an uint32_t */
+        Builder& UINT32(const uint32_t val, const bool descending = false) { return fixed<uint32_t>(val, descending); }
+        /** Append an uint64_t */
+        Builder& UINT64(const uint64_t val, const bool descending = false) { return fixed<uint64_t>(val, descending); }
+        /** Append an int8_t */
+        Builder& INT8(const int8_t val, const bool descending = false) { return fixed<uint8_t>(ENCODE(val), descending); }
+        /** Append an int16_t */
+        Builder& INT16(const int16_t val, const bool descending = false) { return fixed<uint16_t>(ENCODE(val), descending); }
+        /** Append an int32_t */
+        Builder& INT32(const int32_t val, const bool descending = false) { return fixed<uint32_t>(ENCODE(val), descending); }
+        /** Append an int64_t */
+        Builder& INT64(const int64_t val, const bool descending = false) { return fixed<uint64_t>(ENCODE(val), descending); }
+        /** Append a float */
+        Builder& FLOAT32(const float val, const bool descending = false) { return fixed<uint32_t>(ENCODE(val), descending); }
+        /** Append a double */
+        Builder& FLOAT64(const double val, const bool descending = false) { return fixed<uint64_t>(ENCODE(val), descending); }
+
+        /** Append a variable length byte string, escaped and terminated */
+        Builder& BYTES(const uint8_t* data, const size_t size, const bool descending = false)
+        {
+            size_t escaped = size + 2;
+            for(size_t i = 0; i < size; ++i)
+                escaped += data[i] == 0;
+            if(!reserve(escaped))
+                return *this;
+            const uint8_t mask = descending ? 0xFF : 0x00;
+            for(size_t i = 0; i < size; ++i)
+            {
+                _buf[_size++] = data[i] ^ mask;
+                if(data[i] == 0)
+                    _buf[_size++] = 0xFF ^ mask;
+            }
+            _buf[_size++] = 0x00 ^ mask;
+            _buf[_size++] = 0x01 ^ mask;
+            return *this;
+        }
+
+        /** Append a null terminated string, escaped and terminated like BYTES */
+        Builder& TEXT(const char* str, const bool descending = false)
+        {
+            return BYTES(reinterpret_cast<const uint8_t*>(str), strlen(str), descending);
+        }
+
+        /** Pointer to the key */
+        const uint8_t* data() const { return _buf; }
+        /** Size of the key (in bytes) */
+        size_t size() const { return _size; }
+        /** false if a field didn't fit in the buffer. The key is then truncated before this field */
+        bool isValid() const { return _valid; }
+
+    private:
+        template<typename T>
+        Builder& fixed(const T encoded, const bool descending)
+        {
+            if(!reserve(sizeof(T)))
+                return *this;
+            const T value = descending ? T(~encoded) : encoded;
+            for(size_t i = 0; i < sizeof(T); ++i)
+                _buf[_size + i] = uint8_t(value >> (8 * (sizeof(T) - 1 - i)));
+            _size += sizeof(T);
+            return *this;
+        }
+
+        bool reserve(const size_t count)
+        {
+            if(!_valid || _capacity - _size < count)
+                _valid = false;
+            return _valid;
+        }
+
+        uint8_t* _buf;
+        size_t _capacity;
+        size_t _size;
+        bool _valid;
+    };
+
+private:
+    static uint8_t ENCODE(const int8_t val) { return uint8_t(val) ^ uint8_t(0x80); }
+    static uint16_t ENCODE(const int16_t val) { return uint16_t(val) ^ uint16_t(0x8000); }
+    static uint32_t ENCODE(const int32_t val) { return uint32_t(val) ^ uint32_t(0x80000000); }
+    static uint64_t ENCODE(const int64_t val) { return uint64_t(val) ^ uint64_t(0x8000000000000000); }
+
+    static uint32_t ENCODE(const float val)
+    {
+        uint32_t bits;
+        memcpy(&bits, &val, sizeof(bits));
+        return (bits & uint32_t(0x80000000)) ? ~bits : bits ^ uint32_t(0x80000000);
+    }
+
+    static uint64_t ENCODE(const double val)
+    {
+        uint64_t bits;
+        memcpy(&bits, &val, sizeof(bits));
+        return (bits & uint64_t(0x8000000000000000)) ? ~bits : bits ^ uint64_t(0x8000000000000000);
+    }
+
+    /** Inverse of ENCODE. Signed integers flip the sign back, floats undo the total order transform */
+    template<typename T, typename U>
+    static T DECODE(const U encoded)
+    {
+        const U sign = U(U(1) << (8 * sizeof(U) - 1));
+        U bits;
+        if(std::is_floating_point<T>::value)
+            bits = (encoded & sign) ? U(encoded ^ sign) : U(~encoded);
+        else
+            bits = U(encoded ^ sign);
+        T value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    static void SET_ENCODED(uint8_t* buf, const uint32_t encoded) { BigEndian::SET_UINT32(buf, encoded); }
+    static void SET_ENCODED(uint8_t* buf, const uint64_t encoded) { BigEndian::SET_UINT64(buf, encoded); }
+    static uint32_t GET_ENCODED(const uint8_t* buf, uint32_t) { return BigEndian::GET_UINT32(buf); }
+    static uint64_t GET_ENCODED(const uint8_t* buf, uint64_t) { return BigEndian::GET_UINT64(buf); }
+
+    template<typename T>
+    static void SET_ARRAY(uint8_t* dest, const T* src, const size_t count)
+    {
+        for(size_t i = 0; i < count; ++i)
+            SET_ENCODED(dest + i * sizeof(T), ENCODE(src[i]));
+    }
+
+    template<typename T>
+    static void GET_ARRAY(T* dest, const uint8_t* src, const size_t count)
+    {
+        typedef decltype(ENCODE(T())) Encoded;
+        for(size_t i = 0; i < count; ++i)
+            dest[i] = DECODE<T>(GET_ENCODED(src + i * sizeof(T), Encoded()));
+    }
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
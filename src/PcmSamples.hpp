@@ -0,0 +1,350 @@
+/**
+ * \file PcmSamples.hpp
+ * \brief Convert packed PCM audio samples to and from native integers and floats
+ */
+#ifndef __PCM_SAMPLES_HPP__
+#define __PCM_SAMPLES_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianSimd.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Bulk conversion of PCM samples serialized with Endian (BigEndian or LittleEndian).
+ *
+ * 24 bits samples (s24be/s24le) are packed every 3 bytes. They are unpacked 4 at a time with a SSSE3
+ * shuffle that place each sample in the upper 3 bytes of a 32 bits lane, followed by an arithmetic
+ * shift that sign extend it. Float samples are normalized: [-1, 1) maps to [-2^23, 2^23).
+ *
+ * Interleaved 16 and 32 bits samples (s16, s32 or f32) are split into one native order buffer per
+ * channel, and back, in a single pass. For stereo a pshufb swap and transpose 16 bytes at once,
+ * other channel counts swap each sample while scattering it.
+ */
+template<class Endian>
+class PcmSamples : public LibEndian
+{
+public:
+    /** Size of a packed 24 bits sample (3 bytes) */
+    static const uint8_t S24_SIZE = 3;
+    /** Scale between a normalized float and a 24 bits sample */
+    static constexpr float S24_SCALE = 8388608.f;
+
+    /**
+     * \brief Unpack count 24 bits samples into int32_t
+     * \param dest Receive count samples in [-2^23, 2^23)
+     * \param src Buffer of count * S24_SIZE bytes
+     * \param count Number of samples
+     */
+    static void GET_S24_ARRAY(int32_t* dest, const uint8_t* src, const size_t count)
+    {
+        size_t i = 0;
+    #ifdef LIBENDIAN_HAS_SSSE3
+        const __m128i shuffle = UNPACK_24_SHUFFLE();
+        // 16 bytes are loaded for 4 samples (12 bytes), stop while they are still inside src
+        for(; i + 6 <= count; i += 4)
+        {
+            const __m128i x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3)), shuffle);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_srai_epi32(x, 8));
+        }
+    #endif
+        for(; i < count; ++i)
+            dest[i] = GET_S24(src + i * 3);
+    }
+
+    /**
+     * \brief Pack count int32_t into 24 bits samples
+     * \param dest Buffer of count * S24_SIZE bytes
+     * \param src Samples to pack, must be in [-2^23, 2^23). Only the 24 low bits are kept
+     * \param count Number of samples
+     */
+    static void SET_S24_ARRAY(uint8_t* dest, const int32_t* src, const size_t count)
+    {
+        size_t i = 0;
+    #ifdef LIBENDIAN_HAS_SSSE3
+        const __m128i shuffle = PACK_24_SHUFFLE();
+        // 16 bytes are stored for 4 samples (12 bytes), the 4 extra are overwritten by the next iteration.
+        // Stop while they are still inside dest
+        for(; i + 6 <= count; i += 4)
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * 3), _mm_shuffle_epi8(x, shuffle));
+        }
+    #endif
+        for(; i < count; ++i)
+            SET_S24(dest + i * 3, src[i]);
+    }
+
+    /**
+     * \brief Unpack count 24 bits samples into normalized float
+     * \param dest Receive count samples in [-1, 1)
+     * \param src Buffer of count * S24_SIZE bytes
+     * \param count Number of samples
+     */
+    static void GET_S24_FLOAT_ARRAY(float* dest, const uint8_t* src, const size_t count)
+    {
+        size_t i = 0;
+    #ifdef LIBENDIAN_HAS_SSSE3
+        const __m128i shuffle = UNPACK_24_SHUFFLE();
+        const __m128 scale = _mm_set1_ps(1.f / S24_SCALE);
+        for(; i + 6 <= count; i += 4)
+        {
+            const __m128i x = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3)), shuffle);
+            _mm_storeu_ps(dest + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(x, 8)), scale));
+        }
+    #endif
+        for(; i < count; ++i)
+            dest[i] = float(GET_S24(src + i * 3)) * (1.f / S24_SCALE);
+    }
+
+    /**
+     * \brief Pack count normalized float into 24 bits samples
+     * \param dest Buffer of count * S24_SIZE bytes
+     * \param src Samples to pack. They are clipped to [-1, 1) and rounded to the nearest integer
+     * \param count Number of samples
+     */
+    static void SET_S24_FLOAT_ARRAY(uint8_t* dest, const float* src, const size_t count)
+    {
+        size_t i = 0;
+    #ifdef LIBENDIAN_HAS_SSSE3
+        const __m128i shuffle = PACK_24_SHUFFLE();
+        const __m128 scale = _mm_set1_ps(S24_SCALE);
+        const __m128 low = _mm_set1_ps(-S24_SCALE);
+        const __m128 high = _mm_set1_ps(S24_SCALE - 1.f);
+        for(; i + 6 <= count; i += 4)
+        {
+            const __m128 x = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), low), high);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i * 3), _mm_shuffle_epi8(_mm_cvtps_epi32(x), shuffle));
+        }
+    #endif
+        for(; i < count; ++i)
+            SET_S24(dest + i * 3, FLOAT_TO_S24(src[i]));
+    }
+
+    /**
+     * \brief Split interleaved 16 bits samples into one native order buffer per channel
+     * \param planes channels buffers of frames * 2 bytes
+     * \param src Interleaved samples, frames * channels * 2 bytes
+     * \param channels Number of channels
+     * \param frames Number of samples per channel
+     */
+    static void DEINTERLEAVE_16(uint8_t* const* planes, const uint8_t* src, const size_t channels, const size_t frames)
+    {
+        DEINTERLEAVE<2>(planes, src, channels, frames);
+    }
+
+    /**
+     * \brief Split interleaved 32 bits samples (int32_t or float) into one native order buffer per channel
+     * \param planes channels buffers of frames * 4 bytes
+     * \param src Interleaved samples, frames * channels * 4 bytes
+     * \param channels Number of channels
+     * \param frames Number of samples per channel
+     */
+    static void DEINTERLEAVE_32(uint8_t* const* planes, const uint8_t* src, const size_t channels, const size_t frames)
+    {
+        DEINTERLEAVE<4>(planes, src, channels, frames);
+    }
+
+    /**
+     * \brief Interleave one native order buffer per channel into 16 bits samples
+     * \param dest Interleaved samples, frames * channels * 2 bytes
+     * \param planes channels buffers of frames * 2 bytes
+     * \param channels Number of channels
+     * \param frames Number of samples per channel
+     */
+    static void INTERLEAVE_16(uint8_t* dest, const uint8_t* const* planes, const size_t channels, const size_t frames)
+    {
+        INTERLEAVE<2>(dest, planes, channels, frames);
+    }
+
+    /**
+     * \brief Interleave one native order buffer per channel into 32 bits samples (int32_t or float)
+     * \param dest Interleaved samples, frames * channels * 4 bytes
+     * \param planes channels buffers of frames * 4 bytes
+     * \param channels Number of channels
+     * \param frames Number of samples per channel
+     */
+    static void INTERLEAVE_32(uint8_t* dest, const uint8_t* const* planes, const size_t channels, const size_t frames)
+    {
+        INTERLEAVE<4>(dest, planes, channels, frames);
+    }
+
+private:
+    template<int Width>
+    static void DEINTERLEAVE(uint8_t* const* planes, const uint8_t* src, const size_t channels, const size_t frames)
+    {
+        size_t f = 0;
+    #ifdef LIBENDIAN_HAS_SSSE3
+        if(channels == 2)
+        {
+            // Each shuffled vector hold 16 / Width / 2 frames: left samples first, then right ones
+            const __m128i shuffle = STEREO_SHUFFLE<Width>(true);
+            const size_t step = 16 / Width;
+            for(; f + step <= frames; f += step)
+            {
+                const uint8_t* frame = src + f * 2 * Width;
+                const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(frame)), shuffle);
+                const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(frame + 16)), shuffle);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[0] + f * Width), _mm_unpacklo_epi64(a, b));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(planes[1] + f * Width), _mm_unpackhi_epi64(a, b));
+            }
+        }
+    #endif
+        for(; f < frames; ++f)
+        {
+            for(size_t c = 0; c < channels; ++c)
+                GET_SAMPLE<Width>(planes[c] + f * Width, src + (f * channels + c) * Width);
+        }
+    }
+
+    template<int Width>
+    static void INTERLEAVE(uint8_t* dest, const uint8_t* const* planes, const size_t channels, const size_t frames)
+    {
+        size_t f = 0;
+    #ifdef LIBENDIAN_HAS_SSSE3
+        if(channels == 2)
+        {
+            const __m128i shuffle = STEREO_SHUFFLE<Width>(false);
+            const size_t step = 16 / Width;
+            for(; f + step <= frames; f += step)
+            {
+                const __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[0] + f * Width));
+                const __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(planes[1] + f * Width));
+                uint8_t* frame = dest + f * 2 * Width;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(frame), _mm_shuffle_epi8(_mm_unpacklo_epi64(l, r), shuffle));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(frame + 16), _mm_shuffle_epi8(_mm_unpackhi_epi64(l, r), shuffle));
+            }
+        }
+    #endif
+        for(; f < frames; ++f)
+        {
+            for(size_t c = 0; c < channels; ++c)
+                SET_SAMPLE<Width>(dest + (f * channels + c) * Width, planes[c] + f * Width);
+        }
+    }
+
+    /** Copy one sample from Endian to native order */
+    template<int Width>
+    static void GET_SAMPLE(uint8_t* dest, const uint8_t* src)
+    {
+        if(Width == 2)
+        {
+            const uint16_t value = Endian::GET_UINT16(src);
+            memcpy(dest, &value, 2);
+        }
+        else
+        {
+            const uint32_t value = Endian::GET_UINT32(src);
+            memcpy(dest, &value, 4);
+        }
+    }
+
+    /** Copy one sample from native to Endian order */
+    template<int Width>
+    static void SET_SAMPLE(uint8_t* dest, const uint8_t* src)
+    {
+        if(Width == 2)
+        {
+            uint16_t value;
+            memcpy(&value, src, 2);
+            Endian::SET_UINT16(dest, value);
+        }
+        else
+        {
+            uint32_t value;
+            memcpy(&value, src, 4);
+            Endian::SET_UINT32(dest, value);
+        }
+    }
+
+    /** Sign extended 24 bits sample */
+    static int32_t GET_S24(const uint8_t* buf)
+    {
+        const uint32_t value = Endian::IS_BIG_ORDER ?
+            (uint32_t(buf[0]) << 16) | (uint32_t(buf[1]) << 8) | uint32_t(buf[2]) :
+            (uint32_t(buf[2]) << 16) | (uint32_t(buf[1]) << 8) | uint32_t(buf[0]);
+        return int32_t(value ^ 0x800000) - 0x800000;
+    }
+
+    static void SET_S24(uint8_t* buf, const int32_t sample)
+    {
+        const uint32_t value = uint32_t(sample);
+        buf[Endian::IS_BIG_ORDER ? 2 : 0] = uint8_t(value);
+        buf[1] = uint8_t(value >> 8);
+        buf[Endian::IS_BIG_ORDER ? 0 : 2] = uint8_t(value >> 16);
+    }
+
+    /** Same clipping and rounding (to nearest, ties to even) as the SSE path */
+    static int32_t FLOAT_TO_S24(const float sample)
+    {
+        float value = sample * S24_SCALE;
+        if(!(value > -S24_SCALE))
+            value = -S24_SCALE;
+        else if(value > S24_SCALE - 1.f)
+            value = S24_SCALE - 1.f;
+        return int32_t(std::nearbyint(value));
+    }
+
+#ifdef LIBENDIAN_HAS_SSSE3
+    /**
+     * \brief Stereo transpose mask, that also swap the bytes of each sample if needed
+     * \param deinterleave true for L0 R0 L1 R1 ... to L0 L1 ... R0 R1 ..., false for the opposite
+     */
+    template<int Width>
+    static __m128i STEREO_SHUFFLE(const bool deinterleave)
+    {
+        const int half = 8 / Width;
+        const bool swap = !Endian::IS_HOST_ORDER;
+        alignas(16) int8_t mask[16];
+        for(int i = 0; i < 16; ++i)
+        {
+            const int sample = i / Width;
+            const int byte = swap ? Width - 1 - i % Width : i % Width;
+            const int from = deinterleave ?
+                (sample < half ? sample * 2 : (sample - half) * 2 + 1) :
+                (sample % 2 ? half + sample / 2 : sample / 2);
+            mask[i] = int8_t(from * Width + byte);
+        }
+        return _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+    }
+
+    /** Sample bytes in the 3 upper bytes of each 32 bits lane, in native order */
+    static __m128i UNPACK_24_SHUFFLE()
+    {
+        return Endian::IS_BIG_ORDER ?
+            _mm_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9) :
+            _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+    }
+
+    /** 3 low bytes of each 32 bits lane, packed in the first 12 bytes */
+    static __m128i PACK_24_SHUFFLE()
+    {
+        return Endian::IS_BIG_ORDER ?
+            _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1) :
+            _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    }
+#endif
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
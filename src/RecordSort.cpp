@@ -0,0 +1,191 @@
+#include <RecordSort.hpp>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstring>
+
+LIBENDIAN_USING_NAMESPACE;
+
+// ─────────────────────────────────────────────────────────────
+//                  PRIVATE
+// ─────────────────────────────────────────────────────────────
+
+namespace
+{
+
+/** Records of one thread, and where each of its byte values go in the destination */
+struct Chunk
+{
+    size_t begin = 0;
+    size_t end = 0;
+    size_t histogram[256];
+};
+
+/** count - 1 threads started once per sort, that run every pass with the calling thread */
+class WorkerGroup
+{
+public:
+    explicit WorkerGroup(const unsigned count) : _count(count)
+    {
+        _workers.reserve(count - 1);
+        for(unsigned t = 1; t < count; ++t)
+            _workers.emplace_back([this, t]() { work(t); });
+    }
+
+    ~WorkerGroup()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for(auto& worker: _workers)
+            worker.join();
+    }
+
+    /** Run job(t) for t in [0, count), and return once every t is done */
+    void run(const std::function<void(unsigned)>& job)
+    {
+        if(_count == 1)
+        {
+            job(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job = &job;
+            _pending = _count - 1;
+            ++_generation;
+        }
+        _wake.notify_all();
+        job(0);
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]() { return _pending == 0; });
+    }
+
+private:
+    void work(const unsigned t)
+    {
+        size_t generation = 0;
+        for(;;)
+        {
+            const std::function<void(unsigned)>* job;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [&]() { return _stop || _generation != generation; });
+                if(_stop)
+                    return;
+                generation = _generation;
+                job = _job;
+            }
+            (*job)(t);
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(--_pending == 0)
+                _done.notify_one();
+        }
+    }
+
+    const unsigned _count;
+    std::vector<std::thread> _workers;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    const std::function<void(unsigned)>* _job = nullptr;
+    /** Incremented by every run(), so that a worker runs each job once */
+    size_t _generation = 0;
+    unsigned _pending = 0;
+    bool _stop = false;
+};
+
+}
+
+// ─────────────────────────────────────────────────────────────
+//                  FUNCTIONS
+// ─────────────────────────────────────────────────────────────
+
+void RecordSort::SORT(uint8_t* records, const size_t count, const size_t recordSize,
+    const size_t keyOffset, const size_t keyWidth, unsigned threads, uint8_t* scratch)
+{
+    if(count < 2 || !keyWidth || !recordSize)
+        return;
+
+    if(!threads)
+        threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+    if(count < PARALLEL_THRESHOLD)
+        threads = 1;
+
+    std::vector<uint8_t> ownScratch;
+    if(!scratch)
+    {
+        ownScratch.resize(count * recordSize);
+        scratch = ownScratch.data();
+    }
+
+    std::vector<Chunk> chunks(threads);
+    for(unsigned t = 0; t < threads; ++t)
+    {
+        chunks[t].begin = count * t / threads;
+        chunks[t].end = count * (t + 1) / threads;
+    }
+
+    WorkerGroup workers(threads);
+    const uint8_t* src = records;
+    uint8_t* dest = scratch;
+
+    // Least significant byte first, the key is big endian
+    for(size_t byte = keyWidth; byte-- > 0;)
+    {
+        const size_t digitOffset = keyOffset + byte;
+
+        workers.run([&](const unsigned t)
+        {
+            Chunk& chunk = chunks[t];
+            memset(chunk.histogram, 0, sizeof(chunk.histogram));
+            const uint8_t* digit = src + chunk.begin * recordSize + digitOffset;
+            for(size_t i = chunk.begin; i < chunk.end; ++i, digit += recordSize)
+                ++chunk.histogram[*digit];
+        });
+
+        // Skip the pass if every record has the same byte
+        bool trivial = false;
+        for(size_t value = 0; value < 256 && !trivial; ++value)
+        {
+            size_t total = 0;
+            for(const Chunk& chunk: chunks)
+                total += chunk.histogram[value];
+            trivial = total == count;
+        }
+        if(trivial)
+            continue;
+
+        // Exclusive prefix sum over (value, thread), turn counts into destination indexes
+        size_t offset = 0;
+        for(size_t value = 0; value < 256; ++value)
+        {
+            for(Chunk& chunk: chunks)
+            {
+                const size_t n = chunk.histogram[value];
+                chunk.histogram[value] = offset;
+                offset += n;
+            }
+        }
+
+        workers.run([&](const unsigned t)
+        {
+            Chunk& chunk = chunks[t];
+            const uint8_t* record = src + chunk.begin * recordSize;
+            for(size_t i = chunk.begin; i < chunk.end; ++i, record += recordSize)
+                memcpy(dest + chunk.histogram[record[digitOffset]]++ * recordSize, record, recordSize);
+        });
+
+        const uint8_t* previous = src;
+        src = dest;
+        dest = const_cast<uint8_t*>(previous);
+    }
+
+    if(src != records)
+        memcpy(records, src, count * recordSize);
+}
@@ -0,0 +1,64 @@
+/**
+ * \file RecordSort.hpp
+ * \brief Radix sort of fixed size records on a big endian key field
+ */
+#ifndef __RECORD_SORT_HPP__
+#define __RECORD_SORT_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Sort records in place by comparing their key bytes, without decoding them.
+ *
+ * The key is compared like memcmp, which is the numeric order for keys written with
+ * BigEndian::SET_UINTxx, and the order of every type written with OrderedKey.
+ * The sort is a stable LSD radix sort: one pass per key byte, from the last one to the first.
+ * Each pass builds a byte histogram and scatters the records to a scratch buffer.
+ * Passes where every record has the same byte are skipped.
+ *
+ * With several threads, every pass counts and scatters one chunk of records per thread.
+ * The threads are started once per sort, and wait for the next pass between passes.
+ * Offsets are computed per (byte, thread), so the sort stays stable.
+ */
+class LIBENDIAN_API_ RecordSort : public LibEndian
+{
+public:
+    /** Below this number of records, a single thread is used whatever is requested */
+    static const size_t PARALLEL_THRESHOLD = 1 << 16;
+
+    /**
+     * \brief Sort count records of recordSize bytes by their key field
+     * \param records Array of count * recordSize bytes, sorted in place
+     * \param count Number of records
+     * \param recordSize Size of a record (in bytes)
+     * \param keyOffset Offset of the key in a record (in bytes)
+     * \param keyWidth Size of the key (in bytes), 4 for a UINT32 key, 8 for a UINT64 key
+     * \param threads Number of threads, 0 to use every hardware thread
+     * \param scratch Buffer of count * recordSize bytes, allocated internally if nullptr
+     */
+    static void SORT(uint8_t* records, const size_t count, const size_t recordSize,
+        const size_t keyOffset, const size_t keyWidth, unsigned threads = 1, uint8_t* scratch = nullptr);
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
@@ -0,0 +1,319 @@
+/**
+ * \file RuntimeSchema.hpp
+ * \brief Decode records whose layout is only known at runtime, through a compact op program
+ */
+#ifndef __RUNTIME_SCHEMA_HPP__
+#define __RUNTIME_SCHEMA_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+/** Dispatch ops with computed goto (GCC and Clang extension), a switch is used otherwise */
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(LIBENDIAN_DISABLE_COMPUTED_GOTO)
+#define LIBENDIAN_HAS_COMPUTED_GOTO
+#endif
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Layout of packed records serialized with Endian (BigEndian or LittleEndian), built at runtime.
+ *
+ * Fields are appended in serialized order with add() and skip(). Each field is decoded into a native record
+ * laid out like the equivalent C struct: every field at its natural alignment, 48 bits integers widened to
+ * 64 bits, and nativeSize() rounded to the biggest alignment.
+ *
+ * add() compiles the fields into ops as they come: consecutive fields of the same width become one bulk
+ * op (Endian::MEMCPY_xx), and fields that need no swap on this host (bytes, or every field when Endian is
+ * the host order) become one memcpy as long as both layouts stay contiguous. decode() then run the program
+ * of each record with one indirect jump per op instead of one switch per field.
+ *
+ * \code
+ * RuntimeSchema<BigEndian> schema;
+ * schema.add(RuntimeSchema<BigEndian>::FIELD_UINT32, 2).add(RuntimeSchema<BigEndian>::FIELD_FLOAT64).skip(2);
+ * std::vector<uint8_t> records(count * schema.nativeSize());
+ * schema.decode(records.data(), buf, count);
+ * \endcode
+ */
+template<class Endian>
+class RuntimeSchema : public LibEndian
+{
+public:
+    /** Type of a field */
+    enum FieldType
+    {
+        FIELD_UINT8,
+        FIELD_UINT16,
+        FIELD_UINT32,
+        FIELD_UINT48,
+        FIELD_UINT64,
+        FIELD_INT8,
+        FIELD_INT16,
+        FIELD_INT32,
+        FIELD_INT48,
+        FIELD_INT64,
+        FIELD_FLOAT32,
+        FIELD_FLOAT64
+    };
+
+    RuntimeSchema() : _size(0), _nativeSize(0), _alignment(1)
+    {
+        _ops.push_back(Op(OP_END, 0, 0, 0));
+    }
+
+    /**
+     * \brief Append count consecutive fields of type
+     * \return *this, to chain calls
+     */
+    RuntimeSchema& add(const FieldType type, const size_t count = 1)
+    {
+        if(!count)
+            return *this;
+        const size_t width = SERIALIZED_SIZE(type);
+        const size_t nativeWidth = width == 6 ? 8 : width;
+
+        // Natural alignment in the native record
+        if(nativeWidth > _alignment)
+            _alignment = nativeWidth;
+        const size_t nativeOffset = (_nativeSize + nativeWidth - 1) / nativeWidth * nativeWidth;
+        _fields.push_back(nativeOffset);
+
+        OpCode code;
+        if(width == 6)
+            code = type == FIELD_INT48 ? OP_INT48 : OP_UINT48;
+        else if(width == 1 || Endian::IS_HOST_ORDER)
+            code = OP_COPY;
+        else
+            code = width == 2 ? OP_SWAP_16 : width == 4 ? OP_SWAP_32 : OP_SWAP_64;
+
+        // A copy count bytes, other ops count values
+        const size_t units = code == OP_COPY ? count * width : count;
+        Op* const last = _ops.size() > 1 ? &_ops[_ops.size() - 2] : nullptr;
+        const bool mergeable = last && last->code == code &&
+            last->src + last->count * (code == OP_COPY ? 1 : width) == _size &&
+            last->dest + last->count * (code == OP_COPY ? 1 : nativeWidth) == nativeOffset;
+        if(mergeable)
+            last->count += units;
+        else
+            _ops.insert(_ops.end() - 1, Op(code, units, _size, nativeOffset));
+
+        _size += count * width;
+        _nativeSize = nativeOffset + count * nativeWidth;
+        for(size_t i = 1; i < count; ++i)
+            _fields.push_back(nativeOffset + i * nativeWidth);
+        return *this;
+    }
+
+    /** Skip size serialized bytes (padding or ignored fields) */
+    RuntimeSchema& skip(const size_t size)
+    {
+        _size += size;
+        return *this;
+    }
+
+    /** Size of a serialized record (in bytes) */
+    size_t size() const { return _size; }
+    /** Size of a native record (in bytes), including the trailing padding */
+    size_t nativeSize() const { return (_nativeSize + _alignment - 1) / _alignment * _alignment; }
+    /** Number of fields added */
+    size_t fieldCount() const { return _fields.size(); }
+    /** Offset of field index in the native record (in bytes) */
+    size_t nativeOffset(const size_t index) const { return _fields[index]; }
+    /** Number of ops executed per record, after merging */
+    size_t opCount() const { return _ops.size() - 1; }
+
+    /**
+     * \brief Decode count records
+     * \param dest Receive count native records of nativeSize() bytes. Padding bytes are left untouched
+     * \param src count serialized records of size() bytes
+     * \param count Number of records
+     */
+    void decode(void* dest, const uint8_t* src, const size_t count) const
+    {
+        uint8_t* out = static_cast<uint8_t*>(dest);
+        const size_t nativeStride = nativeSize();
+        const Op* const program = _ops.data();
+        for(size_t r = 0; r < count; ++r, out += nativeStride, src += _size)
+        {
+            const Op* op = program;
+        #ifdef LIBENDIAN_HAS_COMPUTED_GOTO
+            // Same order as OpCode
+            static void* const LABELS[] = { &&copy, &&swap16, &&swap32, &&swap64, &&uint48, &&int48, &&end };
+            goto *LABELS[op->code];
+        copy:
+            EXEC_COPY(*op, out, src);
+            goto *LABELS[(++op)->code];
+        swap16:
+            EXEC_SWAP_16(*op, out, src);
+            goto *LABELS[(++op)->code];
+        swap32:
+            EXEC_SWAP_32(*op, out, src);
+            goto *LABELS[(++op)->code];
+        swap64:
+            EXEC_SWAP_64(*op, out, src);
+            goto *LABELS[(++op)->code];
+        uint48:
+            EXEC_UINT48(*op, out, src);
+            goto *LABELS[(++op)->code];
+        int48:
+            EXEC_INT48(*op, out, src);
+            goto *LABELS[(++op)->code];
+        end:
+            ;
+        #else
+            for(; op->code != OP_END; ++op)
+            {
+                switch(op->code)
+                {
+                case OP_COPY: EXEC_COPY(*op, out, src); break;
+                case OP_SWAP_16: EXEC_SWAP_16(*op, out, src); break;
+                case OP_SWAP_32: EXEC_SWAP_32(*op, out, src); break;
+                case OP_SWAP_64: EXEC_SWAP_64(*op, out, src); break;
+                case OP_UINT48: EXEC_UINT48(*op, out, src); break;
+                case OP_INT48: EXEC_INT48(*op, out, src); break;
+                default: break;
+                }
+            }
+        #endif
+        }
+    }
+
+    /** Serialized size of a field of type (in bytes) */
+    static size_t SERIALIZED_SIZE(const FieldType type)
+    {
+        switch(type)
+        {
+        case FIELD_UINT8: case FIELD_INT8: return UINT8_SIZE;
+        case FIELD_UINT16: case FIELD_INT16: return UINT16_SIZE;
+        case FIELD_UINT32: case FIELD_INT32: case FIELD_FLOAT32: return UINT32_SIZE;
+        case FIELD_UINT48: case FIELD_INT48: return UINT48_SIZE;
+        default: return UINT64_SIZE;
+        }
+    }
+
+private:
+    enum OpCode : uint8_t
+    {
+        OP_COPY,
+        OP_SWAP_16,
+        OP_SWAP_32,
+        OP_SWAP_64,
+        OP_UINT48,
+        OP_INT48,
+        OP_END
+    };
+
+    /** count bytes (OP_COPY) or values from src to dest offsets */
+    struct Op
+    {
+        Op(const OpCode c, const size_t n, const size_t s, const size_t d) : code(c), count(n), src(s), dest(d) {}
+        OpCode code;
+        size_t count;
+        size_t src;
+        size_t dest;
+    };
+
+    /** Number of values from which a swap op call Endian::MEMCPY_xx instead of a loop of GET_UINTxx */
+    static const size_t BULK_THRESHOLD = 8;
+
+    static void EXEC_COPY(const Op& op, uint8_t* out, const uint8_t* in)
+    {
+        // A memcpy call cost more than copying a few bytes
+        if(op.count < 2 * UINT64_SIZE)
+        {
+            for(size_t i = 0; i < op.count; ++i)
+                out[op.dest + i] = in[op.src + i];
+        }
+        else
+            memcpy(out + op.dest, in + op.src, op.count);
+    }
+
+    static void EXEC_SWAP_16(const Op& op, uint8_t* out, const uint8_t* in)
+    {
+        if(op.count < BULK_THRESHOLD)
+        {
+            for(size_t i = 0; i < op.count; ++i)
+            {
+                const uint16_t value = Endian::GET_UINT16(in + op.src + i * UINT16_SIZE);
+                memcpy(out + op.dest + i * UINT16_SIZE, &value, UINT16_SIZE);
+            }
+        }
+        else
+            Endian::MEMCPY_16(out + op.dest, in + op.src, op.count, STORE_CACHED);
+    }
+
+    static void EXEC_SWAP_32(const Op& op, uint8_t* out, const uint8_t* in)
+    {
+        if(op.count < BULK_THRESHOLD)
+        {
+            for(size_t i = 0; i < op.count; ++i)
+            {
+                const uint32_t value = Endian::GET_UINT32(in + op.src + i * UINT32_SIZE);
+                memcpy(out + op.dest + i * UINT32_SIZE, &value, UINT32_SIZE);
+            }
+        }
+        else
+            Endian::MEMCPY_32(out + op.dest, in + op.src, op.count, STORE_CACHED);
+    }
+
+    static void EXEC_SWAP_64(const Op& op, uint8_t* out, const uint8_t* in)
+    {
+        if(op.count < BULK_THRESHOLD)
+        {
+            for(size_t i = 0; i < op.count; ++i)
+            {
+                const uint64_t value = Endian::GET_UINT64(in + op.src + i * UINT64_SIZE);
+                memcpy(out + op.dest + i * UINT64_SIZE, &value, UINT64_SIZE);
+            }
+        }
+        else
+            Endian::MEMCPY_64(out + op.dest, in + op.src, op.count, STORE_CACHED);
+    }
+
+    static void EXEC_UINT48(const Op& op, uint8_t* out, const uint8_t* in)
+    {
+        for(size_t i = 0; i < op.count; ++i)
+        {
+            const uint64_t value = Endian::GET_UINT48(in + op.src + i * UINT48_SIZE);
+            memcpy(out + op.dest + i * UINT64_SIZE, &value, UINT64_SIZE);
+        }
+    }
+
+    static void EXEC_INT48(const Op& op, uint8_t* out, const uint8_t* in)
+    {
+        for(size_t i = 0; i < op.count; ++i)
+        {
+            const int64_t value = Endian::GET_INT48(in + op.src + i * UINT48_SIZE);
+            memcpy(out + op.dest + i * UINT64_SIZE, &value, UINT64_SIZE);
+        }
+    }
+
+    size_t _size;
+    size_t _nativeSize;
+    size_t _alignment;
+    /** Native offset of every field */
+    std::vector<size_t> _fields;
+    /** Program of a record, always terminated by OP_END */
+    std::vector<Op> _ops;
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
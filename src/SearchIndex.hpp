@@ -0,0 +1,151 @@
+/**
+ * \file SearchIndex.hpp
+ * \brief Search sorted serialized keys through a cache friendly Eytzinger layout
+ */
+#ifndef __SEARCH_INDEX_HPP__
+#define __SEARCH_INDEX_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianTraits.hpp>
+#include <EndianSimd.hpp>
+#include <AlignedBuffer.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Index over count sorted keys serialized with Endian (BigEndian or LittleEndian).
+ *
+ * Keys are decoded once by build() and stored in native order, in Eytzinger (breadth first) layout:
+ * the children of node k are 2k and 2k + 1. A lookup walk down the tree without branches, and the
+ * nodes 4 levels below (3 for 64 bits keys) share a cache line that is prefetched while the current
+ * level is compared. A lookup then cost about log2(n) / 4 cache misses instead of log2(n) for a
+ * binary search over the serialized keys.
+ *
+ * Keys written with OrderedKey (signed or float) are indexed with Key = uint32_t or uint64_t and
+ * BigEndian, their unsigned order is the order of the original values.
+ */
+template<class Endian, typename Key>
+class SearchIndex
+{
+    static_assert(std::is_integral<Key>::value, "Key must be an integer type");
+
+public:
+    /** Returned by find() when the key is missing */
+    static const size_t NOT_FOUND = size_t(-1);
+
+    SearchIndex() : _count(0) {}
+
+    /**
+     * \brief Build the index
+     * \param keys Pointer to the first serialized key
+     * \param count Number of keys, that must be sorted in ascending order
+     * \param stride Distance between two keys (in bytes), sizeof(Key) when keys are packed
+     */
+    void build(const uint8_t* keys, const size_t count, const size_t stride = sizeof(Key))
+    {
+        _count = count;
+        _tree.resize((count + 1) * sizeof(Key));
+        _ranks.assign(count + 1, count);
+        size_t rank = 0;
+        fill(keys, stride, 1, rank);
+    }
+
+    /** Number of keys in the index */
+    size_t size() const { return _count; }
+
+    /**
+     * \brief Rank (position in the sorted input) of the first key not less than key
+     * \return size() if every key is less than key
+     */
+    size_t lowerBound(const Key key) const
+    {
+        const size_t k = lowerBoundNode(key);
+        return k ? _ranks[k] : _count;
+    }
+
+    /**
+     * \brief Rank of key in the sorted input
+     * \return NOT_FOUND if key isn't indexed
+     */
+    size_t find(const Key key) const
+    {
+        const size_t k = lowerBoundNode(key);
+        return k && nodes()[k] == key ? _ranks[k] : NOT_FOUND;
+    }
+
+    /** True if key is indexed */
+    bool contains(const Key key) const { return find(key) != NOT_FOUND; }
+
+private:
+    /** Number of levels whose 2^levels nodes fill a cache line */
+    static const unsigned PREFETCH_LEVELS = sizeof(Key) <= 4 ? 4 : 3;
+
+    const Key* nodes() const { return reinterpret_cast<const Key*>(_tree.data().get()); }
+
+    /** Node of the first key not less than key, 0 if there is none */
+    size_t lowerBoundNode(const Key key) const
+    {
+        const Key* tree = nodes();
+        size_t k = 1;
+        while(k <= _count)
+        {
+            // Descendants PREFETCH_LEVELS levels below are contiguous, and the tree is cache line aligned
+            LIBENDIAN_PREFETCH(reinterpret_cast<const void*>(uintptr_t(tree) + (k << PREFETCH_LEVELS) * sizeof(Key)));
+            k = 2 * k + (tree[k] < key);
+        }
+        // Go back up to the last node where we went left, it is the answer
+        return k >> (TRAILING_ONES(k) + 1);
+    }
+
+    /** In order traversal of the tree, that receive the keys in ascending order */
+    void fill(const uint8_t* keys, const size_t stride, const size_t k, size_t& rank)
+    {
+        if(k > _count)
+            return;
+        fill(keys, stride, 2 * k, rank);
+        const Key value = EndianTraits<Endian, Key>::GET(keys + rank * stride);
+        memcpy(_tree.data().get() + k * sizeof(Key), &value, sizeof(Key));
+        _ranks[k] = rank++;
+        fill(keys, stride, 2 * k + 1, rank);
+    }
+
+    static unsigned TRAILING_ONES(size_t k)
+    {
+    #if defined(__GNUC__) || defined(__clang__)
+        return unsigned(__builtin_ctzll(~(unsigned long long)k));
+    #else
+        unsigned count = 0;
+        for(; k & 1; k >>= 1)
+            ++count;
+        return count;
+    #endif
+    }
+
+    size_t _count;
+    AlignedBuffer<64> _tree;
+    std::vector<size_t> _ranks;
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * \file SegmentedReader.hpp
+ * \brief Deserialize data from a chain of non contiguous buffers
+ */
+#ifndef __SEGMENTED_READER_HPP__
+#define __SEGMENTED_READER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianTraits.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/** \brief One buffer of a chain */
+struct LIBENDIAN_API_ BufferSegment
+{
+    /** Pointer to the first byte of the segment */
+    const uint8_t* data;
+    /** Size of the segment (in bytes) */
+    size_t size;
+};
+
+/**
+ * \brief Read values from a chain of segments without linearizing it.
+ *
+ * A value that lies inside one segment is read in place with the Endian (BigEndian or LittleEndian) functions.
+ * Only a value that cross a segment boundary is copied into an 8 bytes stitch buffer.
+ * Every read fail without consuming anything if not enough bytes remain.
+ */
+template<class Endian>
+class SegmentedReader
+{
+public:
+    /**
+     * \param segments Array of segments. It isn't copied and must outlive the reader.
+     * \param count Number of segments
+     */
+    SegmentedReader(const BufferSegment* segments, const size_t count) :
+        _segments(segments), _count(count), _index(0), _offset(0), _position(0), _size(0)
+    {
+        for(size_t i = 0; i < count; ++i)
+            _size += segments[i].size;
+        normalize();
+    }
+
+    /** Total number of bytes in the chain */
+    size_t size() const { return _size; }
+    /** Number of bytes already consumed */
+    size_t position() const { return _position; }
+    /** Number of bytes left to read */
+    size_t remaining() const { return _size - _position; }
+
+    /**
+     * \brief Deserialize the next T
+     * \param value Receive the deserialized data
+     * \return false if less than sizeof(T) bytes remain
+     */
+    template<typename T>
+    bool get(T& value)
+    {
+        const size_t size = EndianTraits<Endian, T>::SIZE;
+        if(remaining() < size)
+            return false;
+        const BufferSegment& segment = _segments[_index];
+        if(segment.size - _offset >= size)
+        {
+            value = EndianTraits<Endian, T>::GET(segment.data + _offset);
+            advance(size);
+            return true;
+        }
+        uint8_t stitch[8];
+        copy(stitch, size);
+        value = EndianTraits<Endian, T>::GET(stitch);
+        return true;
+    }
+
+    /**
+     * \brief Deserialize the next T. The caller must check remaining() before.
+     * \return The deserialized data
+     */
+    template<typename T>
+    T get()
+    {
+        T value = T();
+        get(value);
+        return value;
+    }
+
+    /**
+     * \brief Copy the next count bytes into dest
+     * \return false if less than count bytes remain
+     */
+    bool read(uint8_t* dest, const size_t count)
+    {
+        if(remaining() < count)
+            return false;
+        copy(dest, count);
+        return true;
+    }
+
+    /**
+     * \brief Skip the next count bytes
+     * \return false if less than count bytes remain
+     */
+    bool skip(size_t count)
+    {
+        if(remaining() < count)
+            return false;
+        while(count)
+        {
+            const size_t available = _segments[_index].size - _offset;
+            const size_t chunk = count < available ? count : available;
+            advance(chunk);
+            count -= chunk;
+        }
+        return true;
+    }
+
+    /**
+     * \brief Pointer to count contiguous bytes if they lie in the current segment, nullptr otherwise.
+     * Nothing is consumed.
+     */
+    const uint8_t* contiguous(const size_t count) const
+    {
+        if(_index >= _count || _segments[_index].size - _offset < count)
+            return nullptr;
+        return _segments[_index].data + _offset;
+    }
+
+private:
+    void copy(uint8_t* dest, size_t count)
+    {
+        while(count)
+        {
+            const size_t available = _segments[_index].size - _offset;
+            const size_t chunk = count < available ? count : available;
+            memcpy(dest, _segments[_index].data + _offset, chunk);
+            dest += chunk;
+            count -= chunk;
+            advance(chunk);
+        }
+    }
+
+    void advance(const size_t count)
+    {
+        _offset += count;
+        _position += count;
+        normalize();
+    }
+
+    /** Move to the next non empty segment when the current one is exhausted */
+    void normalize()
+    {
+        while(_index < _count && _offset == _segments[_index].size)
+        {
+            ++_index;
+            _offset = 0;
+        }
+    }
+
+    const BufferSegment* _segments;
+    size_t _count;
+    size_t _index;
+    size_t _offset;
+    size_t _position;
+    size_t _size;
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
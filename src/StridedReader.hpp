@@ -0,0 +1,114 @@
+/**
+ * \file StridedReader.hpp
+ * \brief Gather one field out of an array of fixed size records, with software prefetch
+ */
+#ifndef __STRIDED_READER_HPP__
+#define __STRIDED_READER_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianTraits.hpp>
+#include <EndianSimd.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Read the same field of count records laid out every stride bytes.
+ *
+ * Reading `GET_UINT32(base + i * stride + offset)` in a loop stall on a cache miss for every record
+ * once stride is bigger than a cache line. These functions prefetch the field of the record
+ * distance records ahead, so the miss is overlapped with the decoding of the current ones.
+ * A distance of 0 disable the prefetch. The best distance depends on the memory latency and
+ * on the work done per record, see benchmarks/StridedReaderBenchmark.cpp.
+ */
+template<class Endian>
+class StridedReader : public LibEndian
+{
+public:
+    /** Prefetch distance (in records) used when none is given */
+    static const size_t DEFAULT_PREFETCH_DISTANCE = 16;
+
+    /**
+     * \brief Deserialize the field at offset of count records into dest
+     * \param dest Receive count values
+     * \param base Pointer to the first record
+     * \param stride Distance between two records (in bytes)
+     * \param count Number of records
+     * \param offset Offset of the field in a record (in bytes)
+     * \param distance Number of records to prefetch ahead, 0 to disable prefetching
+     */
+    template<typename T>
+    static void GET_STRIDED(T* dest, const uint8_t* base, const size_t stride, const size_t count,
+        const size_t offset, const size_t distance = DEFAULT_PREFETCH_DISTANCE)
+    {
+        const uint8_t* field = base + offset;
+        size_t i = 0;
+        if(distance && count > distance)
+        {
+            // Only prefetch records that exist, the last distance ones are read without prefetch
+            const size_t ahead = distance * stride;
+            for(; i < count - distance; ++i, field += stride)
+            {
+                LIBENDIAN_PREFETCH(field + ahead);
+                dest[i] = EndianTraits<Endian, T>::GET(field);
+            }
+        }
+        for(; i < count; ++i, field += stride)
+            dest[i] = EndianTraits<Endian, T>::GET(field);
+    }
+
+    /** \brief GET_STRIDED for uint16_t fields */
+    static void GET_UINT16_STRIDED(uint16_t* dest, const uint8_t* base, const size_t stride, const size_t count,
+        const size_t offset, const size_t distance = DEFAULT_PREFETCH_DISTANCE)
+    {
+        GET_STRIDED(dest, base, stride, count, offset, distance);
+    }
+
+    /** \brief GET_STRIDED for uint32_t fields */
+    static void GET_UINT32_STRIDED(uint32_t* dest, const uint8_t* base, const size_t stride, const size_t count,
+        const size_t offset, const size_t distance = DEFAULT_PREFETCH_DISTANCE)
+    {
+        GET_STRIDED(dest, base, stride, count, offset, distance);
+    }
+
+    /** \brief GET_STRIDED for uint64_t fields */
+    static void GET_UINT64_STRIDED(uint64_t* dest, const uint8_t* base, const size_t stride, const size_t count,
+        const size_t offset, const size_t distance = DEFAULT_PREFETCH_DISTANCE)
+    {
+        GET_STRIDED(dest, base, stride, count, offset, distance);
+    }
+
+    /** \brief GET_STRIDED for float fields */
+    static void GET_FLOAT32_STRIDED(float* dest, const uint8_t* base, const size_t stride, const size_t count,
+        const size_t offset, const size_t distance = DEFAULT_PREFETCH_DISTANCE)
+    {
+        GET_STRIDED(dest, base, stride, count, offset, distance);
+    }
+
+    /** \brief GET_STRIDED for double fields */
+    static void GET_FLOAT64_STRIDED(double* dest, const uint8_t* base, const size_t stride, const size_t count,
+        const size_t offset, const size_t distance = DEFAULT_PREFETCH_DISTANCE)
+    {
+        GET_STRIDED(dest, base, stride, count, offset, distance);
+    }
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
@@ -0,0 +1,378 @@
+/**
+ * \file TypeConversion.hpp
+ * \brief Widening and narrowing bulk conversions between serialized arrays and native arrays of another type
+ */
+#ifndef __TYPE_CONVERSION_HPP__
+#define __TYPE_CONVERSION_HPP__
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// Application Header
+#include <LibEndian.hpp>
+#include <EndianSimd.hpp>
+
+// C++ Header
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+// ─────────────────────────────────────────────────────────────
+//                  DECLARATION
+// ─────────────────────────────────────────────────────────────
+
+LIBENDIAN_NAMESPACE_START
+
+// ─────────────────────────────────────────────────────────────
+//                  CLASS
+// ─────────────────────────────────────────────────────────────
+
+/**
+ * \brief Convert arrays serialized with Endian (BigEndian or LittleEndian) to native arrays of another type, and back.
+ *
+ * Both types are any of uint8_t to uint64_t, int8_t to int64_t, float and double, e.g. big endian uint16_t
+ * to native float, or native double to big endian float. Arrays are converted BLOCK_SIZE values at a
+ * time: the serialized block is swapped by Endian::MEMCPY_xx to or from a buffer that stays in L1, and
+ * converted by a loop the compiler vectorizes. Each array is read or written once. The compilers don't
+ * vectorize floating point clamps, so double to float and float to int32_t/int16_t have SSE2 kernels.
+ *
+ * Narrowing conversions follow a Rounding and an Overflow mode:
+ * - Rounding apply to floating point to integer conversions. Other conversions to float round to nearest.
+ * - OVERFLOW_SATURATE clamp out of range values to the limits of the destination type: infinities become
+ *   std::numeric_limits<T>::max() and a double too big for a float become FLT_MAX. NaN become 0 in an integer.
+ * - OVERFLOW_WRAP keep the low bits of integer to integer conversions, like static_cast. Floating point
+ *   sources always saturate, as there are no bits to keep.
+ */
+template<class Endian>
+class TypeConversion : public LibEndian
+{
+public:
+    /** Number of values converted at a time */
+    static const size_t BLOCK_SIZE = 256;
+
+    /** How floating point values are converted to integers */
+    enum Rounding
+    {
+        /** Round to the nearest integer, ties to even */
+        ROUND_NEAREST,
+        /** Round toward zero, like static_cast */
+        ROUND_TRUNCATE
+    };
+
+    /** What happen to values that don't fit in the destination type */
+    enum Overflow
+    {
+        /** Clamp to the limits of the destination type */
+        OVERFLOW_SATURATE,
+        /** Keep the low bits of integers */
+        OVERFLOW_WRAP
+    };
+
+    /**
+     * \brief Decode count Serialized values into native Native values
+     * \param dest Receive count values
+     * \param src Buffer of count * sizeof(Serialized) bytes
+     * \param count Number of values
+     *
+     * \code
+     * float samples[1024];
+     * TypeConversion<BigEndian>::GET_ARRAY<uint16_t>(samples, buf, 1024);
+     * \endcode
+     */
+    template<typename Serialized, typename Native>
+    static void GET_ARRAY(Native* dest, const uint8_t* src, const size_t count,
+        const Rounding rounding = ROUND_NEAREST, const Overflow overflow = OVERFLOW_SATURATE)
+    {
+        CHECK_TYPE<Serialized>();
+        CHECK_TYPE<Native>();
+        if(std::is_same<Serialized, Native>::value)
+        {
+            SWAP<Native>(reinterpret_cast<uint8_t*>(dest), src, count, STORE_AUTO);
+            return;
+        }
+        Serialized block[BLOCK_SIZE];
+        const bool inPlace = (Endian::IS_HOST_ORDER || sizeof(Serialized) == 1) && uintptr_t(src) % alignof(Serialized) == 0;
+        for(size_t begin = 0; begin < count; begin += BLOCK_SIZE)
+        {
+            const size_t n = count - begin < BLOCK_SIZE ? count - begin : BLOCK_SIZE;
+            const uint8_t* in = src + begin * sizeof(Serialized);
+            if(!inPlace)
+            {
+                SWAP<Serialized>(reinterpret_cast<uint8_t*>(block), in, n, STORE_CACHED);
+                in = reinterpret_cast<const uint8_t*>(block);
+            }
+            CONVERT_ARRAY(dest + begin, reinterpret_cast<const Serialized*>(in), n, rounding, overflow);
+        }
+    }
+
+    /**
+     * \brief Encode count native Native values as Serialized values
+     * \param dest Buffer of count * sizeof(Serialized) bytes
+     * \param src Values to encode
+     * \param count Number of values
+     *
+     * \code
+     * TypeConversion<BigEndian>::SET_ARRAY<float>(buf, doubles, count);
+     * \endcode
+     */
+    template<typename Serialized, typename Native>
+    static void SET_ARRAY(uint8_t* dest, const Native* src, const size_t count,
+        const Rounding rounding = ROUND_NEAREST, const Overflow overflow = OVERFLOW_SATURATE)
+    {
+        CHECK_TYPE<Serialized>();
+        CHECK_TYPE<Native>();
+        if(std::is_same<Serialized, Native>::value)
+        {
+            SWAP<Native>(dest, reinterpret_cast<const uint8_t*>(src), count, STORE_AUTO);
+            return;
+        }
+        Serialized block[BLOCK_SIZE];
+        const bool inPlace = (Endian::IS_HOST_ORDER || sizeof(Serialized) == 1) && uintptr_t(dest) % alignof(Serialized) == 0;
+        for(size_t begin = 0; begin < count; begin += BLOCK_SIZE)
+        {
+            const size_t n = count - begin < BLOCK_SIZE ? count - begin : BLOCK_SIZE;
+            uint8_t* out = dest + begin * sizeof(Serialized);
+            if(inPlace)
+            {
+                CONVERT_ARRAY(reinterpret_cast<Serialized*>(out), src + begin, n, rounding, overflow);
+                continue;
+            }
+            CONVERT_ARRAY(block, src + begin, n, rounding, overflow);
+            SWAP<Serialized>(out, reinterpret_cast<const uint8_t*>(block), n, STORE_CACHED);
+        }
+    }
+
+    /** Convert a single native value as GET_ARRAY and SET_ARRAY do */
+    template<typename To, typename From>
+    static To CONVERT(const From value, const Rounding rounding = ROUND_NEAREST, const Overflow overflow = OVERFLOW_SATURATE)
+    {
+        if(rounding == ROUND_NEAREST)
+        {
+            return overflow == OVERFLOW_SATURATE ? Converter<To, From, true, true>::CONVERT(value) :
+                Converter<To, From, true, false>::CONVERT(value);
+        }
+        return overflow == OVERFLOW_SATURATE ? Converter<To, From, false, true>::CONVERT(value) :
+            Converter<To, From, false, false>::CONVERT(value);
+    }
+
+private:
+    template<typename T>
+    static void CHECK_TYPE()
+    {
+        static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+            (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8),
+            "Types must be 8, 16, 32 or 64 bits integers, float or double");
+    }
+
+    /** Copy count T from src to dest, swapping them if needed. Blocks are stored cached, they are read again right away */
+    template<typename T>
+    static void SWAP(uint8_t* dest, const uint8_t* src, const size_t count, const StoreMode mode)
+    {
+        switch(sizeof(T))
+        {
+        case 1: if(count) memmove(dest, src, count); break;
+        case 2: Endian::MEMCPY_16(dest, src, count, mode); break;
+        case 4: Endian::MEMCPY_32(dest, src, count, mode); break;
+        default: Endian::MEMCPY_64(dest, src, count, mode); break;
+        }
+    }
+
+    /** Select the loop of the modes once, so each loop has no branch left to vectorize */
+    template<typename To, typename From>
+    static void CONVERT_ARRAY(To* dest, const From* src, const size_t count, const Rounding rounding, const Overflow overflow)
+    {
+        if(rounding == ROUND_NEAREST)
+        {
+            if(overflow == OVERFLOW_SATURATE)
+                Converter<To, From, true, true>::ARRAY(dest, src, count);
+            else
+                Converter<To, From, true, false>::ARRAY(dest, src, count);
+        }
+        else if(overflow == OVERFLOW_SATURATE)
+            Converter<To, From, false, true>::ARRAY(dest, src, count);
+        else
+            Converter<To, From, false, false>::ARRAY(dest, src, count);
+    }
+
+    enum Kind
+    {
+        INTEGER_TO_INTEGER,
+        INTEGER_TO_FLOAT,
+        FLOAT_TO_FLOAT,
+        FLOAT_TO_INTEGER
+    };
+
+    template<typename To, typename From>
+    struct KindOf
+    {
+        static const Kind VALUE = std::is_floating_point<From>::value ?
+            (std::is_floating_point<To>::value ? FLOAT_TO_FLOAT : FLOAT_TO_INTEGER) :
+            (std::is_floating_point<To>::value ? INTEGER_TO_FLOAT : INTEGER_TO_INTEGER);
+    };
+
+    template<typename To, typename From, bool Nearest, bool Saturate, Kind K = KindOf<To, From>::VALUE>
+    struct Converter;
+
+    /**
+     * \brief Convert the head of the array with SSE2 when the compiler can't vectorize the scalar loop
+     * \return Number of values converted, the rest is left to the scalar loop
+     */
+    template<typename To, typename From>
+    static size_t VECTOR_CONVERT(To*, const From*, const size_t, const bool)
+    {
+        return 0;
+    }
+
+#ifdef LIBENDIAN_HAS_SSE2
+    /** Clamp to [-FLT_MAX, FLT_MAX]: max_pd and min_pd return their second operand, x, when it is NaN */
+    static size_t VECTOR_CONVERT(float* dest, const double* src, const size_t count, const bool)
+    {
+        const __m128d high = _mm_set1_pd(double(std::numeric_limits<float>::max()));
+        const __m128d low = _mm_set1_pd(-double(std::numeric_limits<float>::max()));
+        size_t i = 0;
+        for(; i + 4 <= count; i += 4)
+        {
+            const __m128 a = _mm_cvtpd_ps(_mm_min_pd(high, _mm_max_pd(low, _mm_loadu_pd(src + i))));
+            const __m128 b = _mm_cvtpd_ps(_mm_min_pd(high, _mm_max_pd(low, _mm_loadu_pd(src + i + 2))));
+            _mm_storeu_ps(dest + i, _mm_movelh_ps(a, b));
+        }
+        return i;
+    }
+
+    /**
+     * cvtps2dq round with the MXCSR mode (to nearest even by default) and return INT32_MIN for NaN and out
+     * of range values: it is already the saturation of negative values, the others are fixed with masks
+     */
+    static __m128i FLOAT_TO_INT32(const __m128 x, const bool nearest)
+    {
+        const __m128i value = nearest ? _mm_cvtps_epi32(x) : _mm_cvttps_epi32(x);
+        const __m128i tooBig = _mm_castps_si128(_mm_cmpge_ps(x, _mm_set1_ps(2147483648.f)));
+        const __m128i ordered = _mm_castps_si128(_mm_cmpord_ps(x, x));
+        return _mm_and_si128(_mm_xor_si128(value, tooBig), ordered);
+    }
+
+    static size_t VECTOR_CONVERT(int32_t* dest, const float* src, const size_t count, const bool nearest)
+    {
+        size_t i = 0;
+        for(; i + 4 <= count; i += 4)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), FLOAT_TO_INT32(_mm_loadu_ps(src + i), nearest));
+        return i;
+    }
+
+    /** packssdw saturate the int32 to int16 */
+    static size_t VECTOR_CONVERT(int16_t* dest, const float* src, const size_t count, const bool nearest)
+    {
+        size_t i = 0;
+        for(; i + 8 <= count; i += 8)
+        {
+            const __m128i a = FLOAT_TO_INT32(_mm_loadu_ps(src + i), nearest);
+            const __m128i b = FLOAT_TO_INT32(_mm_loadu_ps(src + i + 4), nearest);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_packs_epi32(a, b));
+        }
+        return i;
+    }
+#endif
+
+    template<typename To, typename From, bool Nearest, bool Saturate>
+    struct ConverterArray
+    {
+        static void ARRAY(To* dest, const From* src, const size_t count)
+        {
+            for(size_t i = VECTOR_CONVERT(dest, src, count, Nearest); i < count; ++i)
+                dest[i] = Converter<To, From, Nearest, Saturate>::CONVERT(src[i]);
+        }
+    };
+
+    template<typename To, typename From, bool Nearest, bool Saturate>
+    struct Converter<To, From, Nearest, Saturate, INTEGER_TO_INTEGER> : ConverterArray<To, From, Nearest, Saturate>
+    {
+        static To CONVERT(const From value)
+        {
+            if(!Saturate)
+                return To(value);
+            // Compare in the type that hold both ranges, the limits that can't be crossed are skipped
+            if(std::is_signed<From>::value && !std::is_signed<To>::value)
+            {
+                if(value < From(0))
+                    return To(0);
+                return sizeof(From) > sizeof(To) && value > From(std::numeric_limits<To>::max()) ?
+                    std::numeric_limits<To>::max() : To(value);
+            }
+            if(!std::is_signed<From>::value && std::is_signed<To>::value)
+            {
+                return sizeof(From) >= sizeof(To) && value > From(std::numeric_limits<To>::max()) ?
+                    std::numeric_limits<To>::max() : To(value);
+            }
+            if(sizeof(From) <= sizeof(To))
+                return To(value);
+            return value < From(std::numeric_limits<To>::lowest()) ? std::numeric_limits<To>::lowest() :
+                value > From(std::numeric_limits<To>::max()) ? std::numeric_limits<To>::max() : To(value);
+        }
+    };
+
+    template<typename To, typename From, bool Nearest, bool Saturate>
+    struct Converter<To, From, Nearest, Saturate, INTEGER_TO_FLOAT> : ConverterArray<To, From, Nearest, Saturate>
+    {
+        static To CONVERT(const From value) { return To(value); }
+    };
+
+    template<typename To, typename From, bool Nearest, bool Saturate>
+    struct Converter<To, From, Nearest, Saturate, FLOAT_TO_FLOAT> : ConverterArray<To, From, Nearest, Saturate>
+    {
+        static To CONVERT(const From value)
+        {
+            if(sizeof(From) <= sizeof(To))
+                return To(value);
+            // Clamp before converting, so the loop compile to min/max instructions. NaN go through
+            const From high = From(std::numeric_limits<To>::max());
+            const From x = value > high ? high : value;
+            return To(x < -high ? -high : x);
+        }
+    };
+
+    template<typename To, typename From, bool Nearest, bool Saturate>
+    struct Converter<To, From, Nearest, Saturate, FLOAT_TO_INTEGER> : ConverterArray<To, From, Nearest, Saturate>
+    {
+        /** Float is enough to hold every To up to 16 bits, which keep 4 values per SSE register */
+        typedef typename std::conditional<std::numeric_limits<To>::digits <= std::numeric_limits<From>::digits, From, double>::type Work;
+
+        static To CONVERT(const From value)
+        {
+            // Limits as powers of two, exact in Work: the upper one is excluded
+            const Work low = std::is_signed<To>::value ? -TWO_POWER(std::numeric_limits<To>::digits) : Work(0);
+            const Work high = TWO_POWER(std::numeric_limits<To>::digits);
+            Work x = Work(value);
+            if(Nearest)
+            {
+                // Adding 2^(mantissa bits) push the fraction out of the mantissa, the FPU round it to nearest even.
+                // Bigger values are already integers
+                const Work shift = TWO_POWER(std::numeric_limits<Work>::digits - 1);
+                const Work magnitude = x < 0 ? -x : x;
+                const Work rounded = magnitude < shift ? (magnitude + shift) - shift : magnitude;
+                x = x < 0 ? -rounded : rounded;
+            }
+            // NaN fail every comparison
+            x = x == x ? x : Work(0);
+            x = x > low ? x : low;
+            if(std::numeric_limits<To>::digits < std::numeric_limits<Work>::digits)
+            {
+                // high - 1 is exact: a plain clamp, without branch
+                const Work top = high - Work(1);
+                return To(x < top ? x : top);
+            }
+            return x >= high ? std::numeric_limits<To>::max() : To(x);
+        }
+
+        static Work TWO_POWER(const int exponent)
+        {
+            return exponent >= 32 ? Work(4294967296.) * Work(uint64_t(1) << (exponent - 32)) : Work(uint64_t(1) << exponent);
+        }
+    };
+};
+
+LIBENDIAN_NAMESPACE_END
+
+#endif
@@ -0,0 +1,538 @@
+/**
+ * \file EndnGen.cpp
+ * \brief endn-gen: generate C++ serializers from a message schema
+ *
+ * Usage: endn-gen <schema> <output.hpp>
+ *
+ * \code
+ * # Comments start with '#' or '//'
+ * namespace net.proto;
+ * endian big;              # big (default) or little, apply to the messages that follow
+ *
+ * message Position
+ * {
+ *     float64 latitude;
+ *     float64 longitude;
+ * }
+ *
+ * message Report
+ * {
+ *     uint16 magic;
+ *     uint8 mac[6];        # fixed size array
+ *     int48 timestamp;
+ *     Position position;   # previously declared message
+ * }
+ * \endcode
+ *
+ * Types are uint8/16/32/48/64, int8/16/32/48/64, float32/64 and messages. Every field has a fixed offset, so
+ * each generated message is a struct with SIZE, <FIELD>_OFFSET constants, ENCODE/DECODE functions made of
+ * one BigEndian or LittleEndian call per field, and View/MutableView accessors that read or write the
+ * serialized buffer in place. Nothing is interpreted at runtime.
+ */
+
+// ─────────────────────────────────────────────────────────────
+//                  INCLUDE
+// ─────────────────────────────────────────────────────────────
+
+// C++ Header
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ─────────────────────────────────────────────────────────────
+//                  PRIVATE
+// ─────────────────────────────────────────────────────────────
+
+namespace
+{
+
+/** Built-in type of the schema */
+struct Primitive
+{
+    const char* name;
+    const char* cppType;
+    /** Suffix of the GET_ and SET_ functions */
+    const char* function;
+    size_t size;
+};
+
+const Primitive PRIMITIVES[] =
+{
+    { "uint8", "uint8_t", "UINT8", 1 },
+    { "uint16", "uint16_t", "UINT16", 2 },
+    { "uint32", "uint32_t", "UINT32", 4 },
+    { "uint48", "uint64_t", "UINT48", 6 },
+    { "uint64", "uint64_t", "UINT64", 8 },
+    { "int8", "int8_t", "INT8", 1 },
+    { "int16", "int16_t", "INT16", 2 },
+    { "int32", "int32_t", "INT32", 4 },
+    { "int48", "int64_t", "INT48", 6 },
+    { "int64", "int64_t", "INT64", 8 },
+    { "float32", "float", "FLOAT32", 4 },
+    { "float64", "double", "FLOAT64", 8 },
+};
+
+/** Members of the generated code, that messages and fields can't use */
+const std::set<std::string> RESERVED = { "SIZE", "IS_VALID", "ENCODE", "DECODE", "View", "MutableView", "data", "_buf" };
+
+/** C++ keywords, that can't name a namespace, a message or a field */
+const std::set<std::string> KEYWORDS = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char",
+    "char16_t", "char32_t", "class", "compl", "const", "const_cast", "constexpr", "continue", "decltype", "default",
+    "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for",
+    "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq",
+    "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "return",
+    "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template", "this",
+    "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual",
+    "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+};
+
+struct Message;
+
+struct Field
+{
+    std::string name;
+    /** Either primitive or message is set */
+    const Primitive* primitive = nullptr;
+    const Message* message = nullptr;
+    /** Number of elements, 0 for a scalar */
+    size_t count = 0;
+    size_t offset = 0;
+
+    size_t elementSize() const;
+    size_t size() const { return elementSize() * (count ? count : 1); }
+};
+
+struct Message
+{
+    std::string name;
+    std::string endian;
+    std::vector<Field> fields;
+    size_t size = 0;
+};
+
+size_t Field::elementSize() const { return primitive ? primitive->size : message->size; }
+
+struct Schema
+{
+    std::vector<std::string> namespaces;
+    /** Messages in declaration order, a message only reference the previous ones. A deque never move them */
+    std::deque<Message> messages;
+};
+
+/** Split the schema in identifiers, numbers and punctuation, and keep the line of each token */
+class Lexer
+{
+public:
+    Lexer(const std::string& path, const std::string& text) : _path(path), _text(text) {}
+
+    bool atEnd() { skip(); return _position >= _text.size(); }
+
+    std::string next()
+    {
+        skip();
+        if(_position >= _text.size())
+            fail("unexpected end of file");
+        const size_t begin = _position;
+        if(isalnum(uint8_t(_text[_position])) || _text[_position] == '_')
+        {
+            while(_position < _text.size() && (isalnum(uint8_t(_text[_position])) || _text[_position] == '_'))
+                ++_position;
+        }
+        else
+            ++_position;
+        return _text.substr(begin, _position - begin);
+    }
+
+    void expect(const std::string& token)
+    {
+        const std::string got = next();
+        if(got != token)
+            fail("expected '" + token + "' but got '" + got + "'");
+    }
+
+    std::string identifier()
+    {
+        const std::string got = next();
+        if(!isalpha(uint8_t(got[0])) && got[0] != '_')
+            fail("expected an identifier but got '" + got + "'");
+        return got;
+    }
+
+    [[noreturn]] void fail(const std::string& message) const
+    {
+        fprintf(stderr, "%s:%zu: error: %s\n", _path.c_str(), _line, message.c_str());
+        exit(EXIT_FAILURE);
+    }
+
+private:
+    void skip()
+    {
+        while(_position < _text.size())
+        {
+            const char c = _text[_position];
+            if(c == '\n')
+                ++_line;
+            if(isspace(uint8_t(c)))
+                ++_position;
+            else if(c == '#' || _text.compare(_position, 2, "//") == 0)
+            {
+                while(_position < _text.size() && _text[_position] != '\n')
+                    ++_position;
+            }
+            else
+                break;
+        }
+    }
+
+    std::string _path;
+    std::string _text;
+    size_t _position = 0;
+    size_t _line = 1;
+};
+
+const Primitive* findPrimitive(const std::string& name)
+{
+    for(const Primitive& primitive: PRIMITIVES)
+    {
+        if(name == primitive.name)
+            return &primitive;
+    }
+    return nullptr;
+}
+
+std::string upper(const std::string& name)
+{
+    std::string result;
+    for(size_t i = 0; i < name.size(); ++i)
+    {
+        // camelCase to CAMEL_CASE
+        if(i && isupper(uint8_t(name[i])) && (islower(uint8_t(name[i - 1])) || isdigit(uint8_t(name[i - 1]))))
+            result += '_';
+        result += char(toupper(uint8_t(name[i])));
+    }
+    return result;
+}
+
+Schema parse(const std::string& path, const std::string& text)
+{
+    Lexer lexer(path, text);
+    Schema schema;
+    std::string endian = "BigEndian";
+    std::map<std::string, size_t> messages;
+
+    while(!lexer.atEnd())
+    {
+        const std::string keyword = lexer.identifier();
+        if(keyword == "namespace")
+        {
+            schema.namespaces.clear();
+            schema.namespaces.push_back(lexer.identifier());
+            std::string token;
+            while((token = lexer.next()) == ".")
+                schema.namespaces.push_back(lexer.identifier());
+            if(token != ";")
+                lexer.fail("expected ';' after namespace");
+            for(const std::string& name: schema.namespaces)
+            {
+                if(KEYWORDS.count(name))
+                    lexer.fail("'" + name + "' is a C++ keyword");
+            }
+        }
+        else if(keyword == "endian")
+        {
+            const std::string order = lexer.identifier();
+            if(order == "big")
+                endian = "BigEndian";
+            else if(order == "little")
+                endian = "LittleEndian";
+            else
+                lexer.fail("endian must be 'big' or 'little'");
+            lexer.expect(";");
+        }
+        else if(keyword == "message")
+        {
+            Message message;
+            message.name = lexer.identifier();
+            message.endian = endian;
+            if(KEYWORDS.count(message.name))
+                lexer.fail("'" + message.name + "' is a C++ keyword");
+            if(RESERVED.count(message.name))
+                lexer.fail("'" + message.name + "' is reserved by the generated code");
+            if(messages.count(message.name) || findPrimitive(message.name))
+                lexer.fail("'" + message.name + "' is already defined");
+            lexer.expect("{");
+
+            // Members of the generated struct: field names and their <FIELD>_OFFSET constants
+            std::set<std::string> names;
+            std::string type;
+            while((type = lexer.next()) != "}")
+            {
+                Field field;
+                field.primitive = findPrimitive(type);
+                if(!field.primitive)
+                {
+                    const auto it = messages.find(type);
+                    if(it == messages.end())
+                        lexer.fail("unknown type '" + type + "'");
+                    field.message = &schema.messages[it->second];
+                }
+                field.name = lexer.identifier();
+                if(RESERVED.count(field.name))
+                    lexer.fail("'" + field.name + "' is reserved by the generated code");
+                if(KEYWORDS.count(field.name))
+                    lexer.fail("'" + field.name + "' is a C++ keyword");
+                if(field.name == message.name)
+                    lexer.fail("field '" + field.name + "' has the name of its message");
+                // Inside the struct, the field would hide the message type used by the generated code
+                if(messages.count(field.name))
+                    lexer.fail("field '" + field.name + "' has the name of a message");
+                if(!names.insert(field.name).second)
+                    lexer.fail("'" + field.name + "' is already a member of '" + message.name + "'");
+                const std::string offset = upper(field.name) + "_OFFSET";
+                if(!names.insert(offset).second)
+                    lexer.fail("field '" + field.name + "' generates " + offset + ", already a member of '" + message.name + "'");
+
+                std::string token = lexer.next();
+                if(token == "[")
+                {
+                    const std::string count = lexer.next();
+                    if(!isdigit(uint8_t(count[0])) || !(field.count = strtoull(count.c_str(), nullptr, 10)))
+                        lexer.fail("array size must be a positive number");
+                    lexer.expect("]");
+                    token = lexer.next();
+                }
+                if(token != ";")
+                    lexer.fail("expected ';' after field '" + field.name + "'");
+
+                field.offset = message.size;
+                message.size += field.size();
+                message.fields.push_back(field);
+            }
+            messages[message.name] = schema.messages.size();
+            schema.messages.push_back(message);
+        }
+        else
+            lexer.fail("expected 'namespace', 'endian' or 'message' but got '" + keyword + "'");
+    }
+    return schema;
+}
+
+/** Expression of the serialized address of field (element i if it is an array) */
+std::string address(const char* buf, const Field& field, const bool indexed)
+{
+    std::ostringstream out;
+    out << buf << " + " << upper(field.name) << "_OFFSET";
+    if(indexed)
+        out << " + i * " << field.elementSize();
+    return out.str();
+}
+
+void generateEncode(std::ostream& out, const Message& message)
+{
+    const std::string endian = "LIBENDIAN_NAMESPACE::" + message.endian;
+    out << "    /** Serialize msg into buf, of at least SIZE bytes */\n";
+    out << "    static void ENCODE(uint8_t* buf, const " << message.name << "& msg)\n    {\n";
+    for(const Field& field: message.fields)
+    {
+        const std::string value = "msg." + field.name;
+        if(field.message && !field.count)
+            out << "        " << field.message->name << "::ENCODE(" << address("buf", field, false) << ", " << value << ");\n";
+        else if(field.message)
+            out << "        for(size_t i = 0; i < " << field.count << "; ++i)\n            "
+                << field.message->name << "::ENCODE(" << address("buf", field, true) << ", " << value << "[i]);\n";
+        else if(!field.count)
+            out << "        " << endian << "::SET_" << field.primitive->function << "(" << address("buf", field, false) << ", " << value << ");\n";
+        else if(field.primitive->size == 1)
+            out << "        memcpy(" << address("buf", field, false) << ", " << value << ", " << field.count << ");\n";
+        else if(field.primitive->size == 6)
+            out << "        " << endian << "::SET_" << field.primitive->function << "_ARRAY(" << address("buf", field, false)
+                << ", " << value << ", " << field.count << ");\n";
+        else
+            out << "        " << endian << "::MEMCPY_" << field.primitive->size * 8 << "(" << address("buf", field, false)
+                << ", reinterpret_cast<const uint8_t*>(" << value << "), " << field.count << ");\n";
+    }
+    out << "    }\n\n";
+}
+
+void generateDecode(std::ostream& out, const Message& message)
+{
+    const std::string endian = "LIBENDIAN_NAMESPACE::" + message.endian;
+    out << "    /** Deserialize buf, of at least SIZE bytes, into msg */\n";
+    out << "    static void DECODE(const uint8_t* buf, " << message.name << "& msg)\n    {\n";
+    for(const Field& field: message.fields)
+    {
+        const std::string value = "msg." + field.name;
+        if(field.message && !field.count)
+            out << "        " << field.message->name << "::DECODE(" << address("buf", field, false) << ", " << value << ");\n";
+        else if(field.message)
+            out << "        for(size_t i = 0; i < " << field.count << "; ++i)\n            "
+                << field.message->name << "::DECODE(" << address("buf", field, true) << ", " << value << "[i]);\n";
+        else if(!field.count)
+            out << "        " << value << " = " << endian << "::GET_" << field.primitive->function << "(" << address("buf", field, false) << ");\n";
+        else if(field.primitive->size == 1)
+            out << "        memcpy(" << value << ", " << address("buf", field, false) << ", " << field.count << ");\n";
+        else if(field.primitive->size == 6)
+            out << "        " << endian << "::GET_" << field.primitive->function << "_ARRAY(" << value << ", "
+                << address("buf", field, false) << ", " << field.count << ");\n";
+        else
+            out << "        " << endian << "::MEMCPY_" << field.primitive->size * 8 << "(reinterpret_cast<uint8_t*>(" << value
+                << "), " << address("buf", field, false) << ", " << field.count << ");\n";
+    }
+    out << "    }\n\n";
+}
+
+void generateView(std::ostream& out, const Message& message, const bool mutableView)
+{
+    const std::string endian = "LIBENDIAN_NAMESPACE::" + message.endian;
+    const std::string name = mutableView ? "MutableView" : "View";
+    const std::string pointer = mutableView ? "uint8_t*" : "const uint8_t*";
+
+    if(mutableView)
+        out << "    /** \\brief Write the fields of a serialized " << message.name << " in place */\n";
+    else
+        out << "    /** \\brief Read the fields of a serialized " << message.name << " in place, without copy */\n";
+    out << "    class " << name << "\n    {\n    public:\n";
+    out << "        " << name << "(" << pointer << " buf = nullptr) : _buf(buf) {}\n\n";
+    out << "        /** Pointer to the serialized message */\n";
+    out << "        " << pointer << " data() const { return _buf; }\n";
+
+    for(const Field& field: message.fields)
+    {
+        const bool array = field.count != 0;
+        const std::string index = array ? "const size_t i" : "";
+        if(field.message)
+        {
+            out << "        " << field.message->name << "::" << name << " " << field.name << "(" << index << ") const { return "
+                << field.message->name << "::" << name << "(" << address("_buf", field, array) << "); }\n";
+            continue;
+        }
+        const std::string type = field.primitive->cppType;
+        if(mutableView)
+            out << "        void " << field.name << "(" << (array ? index + ", " : std::string()) << "const " << type << " value) const { "
+                << endian << "::SET_" << field.primitive->function << "(" << address("_buf", field, array) << ", value); }\n";
+        else
+            out << "        " << type << " " << field.name << "(" << index << ") const { return "
+                << endian << "::GET_" << field.primitive->function << "(" << address("_buf", field, array) << "); }\n";
+    }
+    out << "\n    private:\n        " << pointer << " _buf;\n    };\n";
+}
+
+void generateMessage(std::ostream& out, const Message& message)
+{
+    out << "/** \\brief " << message.name << ", serialized in " << message.size << " bytes with " << message.endian << " */\n";
+    out << "struct " << message.name << "\n{\n";
+    out << "    /** Size of the serialized message (in bytes) */\n";
+    out << "    static const size_t SIZE = " << message.size << ";\n";
+    for(const Field& field: message.fields)
+        out << "    static const size_t " << upper(field.name) << "_OFFSET = " << field.offset << ";\n";
+    out << "\n";
+
+    for(const Field& field: message.fields)
+    {
+        const std::string type = field.primitive ? field.primitive->cppType : field.message->name;
+        out << "    " << type << " " << field.name;
+        if(field.count)
+            out << "[" << field.count << "]";
+        out << ";\n";
+    }
+    out << "\n";
+
+    out << "    /** Check that length bytes can hold a serialized message */\n";
+    out << "    static bool IS_VALID(const uint8_t*, const size_t length) { return length >= SIZE; }\n\n";
+    generateEncode(out, message);
+    generateDecode(out, message);
+    generateView(out, message, false);
+    out << "\n";
+    generateView(out, message, true);
+    out << "};\n\n";
+}
+
+std::string fileName(const std::string& path)
+{
+    const size_t slash = path.find_last_of("/\\");
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+void generate(std::ostream& out, const Schema& schema, const std::string& schemaPath, const std::string& outputPath)
+{
+    std::string guard = "__";
+    for(const char c: fileName(outputPath))
+        guard += isalnum(uint8_t(c)) ? char(toupper(uint8_t(c))) : '_';
+    guard += "__";
+
+    out << "/**\n * \\file " << fileName(outputPath) << "\n * \\brief Generated by endn-gen from "
+        << fileName(schemaPath) << ", do not edit\n */\n";
+    out << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+    out << "// Application Header\n#include <BigEndian.hpp>\n#include <LittleEndian.hpp>\n\n";
+    out << "// C++ Header\n#include <cstdint>\n#include <cstddef>\n#include <cstring>\n\n";
+
+    for(const std::string& name: schema.namespaces)
+        out << "namespace " << name << " {\n";
+    if(!schema.namespaces.empty())
+        out << "\n";
+
+    for(const Message& message: schema.messages)
+        generateMessage(out, message);
+
+    for(size_t i = schema.namespaces.size(); i-- > 0;)
+        out << "} // " << schema.namespaces[i] << "\n";
+    if(!schema.namespaces.empty())
+        out << "\n";
+    out << "#endif\n";
+}
+
+}
+
+// ─────────────────────────────────────────────────────────────
+//                  FUNCTIONS
+// ─────────────────────────────────────────────────────────────
+
+int main(int argc, char** argv)
+{
+    if(argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <schema> <output.hpp>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if(!input)
+    {
+        fprintf(stderr, "%s: error: can't open the schema\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    std::stringstream text;
+    text << input.rdbuf();
+
+    const Schema schema = parse(argv[1], text.str());
+
+    std::ostringstream generated;
+    generate(generated, schema, argv[1], argv[2]);
+
+    // Keep the timestamp of an unchanged output, so dependent files aren't rebuilt
+    std::ifstream previous(argv[2], std::ios::binary);
+    if(previous)
+    {
+        std::stringstream content;
+        content << previous.rdbuf();
+        if(content.str() == generated.str())
+            return EXIT_SUCCESS;
+    }
+
+    std::ofstream output(argv[2], std::ios::binary);
+    output << generated.str();
+    if(!output)
+    {
+        fprintf(stderr, "%s: error: can't write the output\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}